@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Pinetime {
+  namespace Controllers {
+    enum class ChangeEvents : uint8_t { Second, Minute, Battery, Ble, Notification, HeartRate, Steps, Weather };
+
+    using ChangeEventMask = uint8_t;
+
+    constexpr ChangeEventMask ToMask(ChangeEvents event) {
+      return static_cast<ChangeEventMask>(1U << static_cast<uint8_t>(event));
+    }
+
+    template <typename... Events>
+    constexpr ChangeEventMask ToMask(ChangeEvents event, Events... events) {
+      return static_cast<ChangeEventMask>(ToMask(event) | ToMask(events...));
+    }
+
+    // Receives a notification each time the state of a controller changes.
+    // OnChange() may be called from any task or from an interrupt handler, so it must not block.
+    class ChangeListener {
+    public:
+      virtual void OnChange(ChangeEvents event) = 0;
+
+    protected:
+      ~ChangeListener() = default;
+    };
+  }
+}
@@ -16,6 +16,9 @@ Battery::Battery() {
 }
 
 void Battery::ReadPowerState() {
+  const bool wasCharging = IsCharging();
+  const bool wasPowerPresent = isPowerPresent;
+
   isCharging = (nrf_gpio_pin_read(PinMap::Charging) == 0);
   isPowerPresent = (nrf_gpio_pin_read(PinMap::PowerPresent) == 0);
 
@@ -24,6 +27,10 @@ void Battery::ReadPowerState() {
   } else if (!isPowerPresent) {
     isFull = false;
   }
+
+  if (changeListener != nullptr && (IsCharging() != wasCharging || isPowerPresent != wasPowerPresent)) {
+    changeListener->OnChange(ChangeEvents::Battery);
+  }
 }
 
 void Battery::MeasureVoltage() {
@@ -85,6 +92,9 @@ void Battery::SaadcEventHandler(nrfx_saadc_evt_t const* p_event) {
       firstMeasurement = false;
       percentRemaining = newPercent;
       systemTask->PushMessage(System::Messages::BatteryPercentageUpdated);
+      if (changeListener != nullptr) {
+        changeListener->OnChange(ChangeEvents::Battery);
+      }
     }
 
     nrfx_saadc_uninit();
@@ -95,3 +105,7 @@ void Battery::SaadcEventHandler(nrfx_saadc_evt_t const* p_event) {
 void Battery::Register(Pinetime::System::SystemTask* systemTask) {
   this->systemTask = systemTask;
 }
+
+void Battery::SetChangeListener(ChangeListener* listener) {
+  changeListener = listener;
+}
@@ -2,6 +2,7 @@
 #include <cstdint>
 #include <drivers/include/nrfx_saadc.h>
 #include <systemtask/SystemTask.h>
+#include "components/ChangeListener.h"
 
 namespace Pinetime {
   namespace Controllers {
@@ -13,6 +14,7 @@ namespace Pinetime {
       void ReadPowerState();
       void MeasureVoltage();
       void Register(System::SystemTask* systemTask);
+      void SetChangeListener(ChangeListener* listener);
 
       uint8_t PercentRemaining() const {
         return percentRemaining;
@@ -53,6 +55,7 @@ namespace Pinetime {
       bool isReading = false;
 
       Pinetime::System::SystemTask* systemTask = nullptr;
+      ChangeListener* changeListener = nullptr;
     };
   }
 }
@@ -8,10 +8,12 @@ bool Ble::IsConnected() const {
 
 void Ble::Connect() {
   isConnected = true;
+  NotifyChange();
 }
 
 void Ble::Disconnect() {
   isConnected = false;
+  NotifyChange();
 }
 
 bool Ble::IsRadioEnabled() const {
@@ -20,10 +22,12 @@ bool Ble::IsRadioEnabled() const {
 
 void Ble::EnableRadio() {
   isRadioEnabled = true;
+  NotifyChange();
 }
 
 void Ble::DisableRadio() {
   isRadioEnabled = false;
+  NotifyChange();
 }
 
 void Ble::StartFirmwareUpdate() {
@@ -41,3 +45,9 @@ void Ble::FirmwareUpdateTotalBytes(uint32_t totalBytes) {
 void Ble::FirmwareUpdateCurrentBytes(uint32_t currentBytes) {
   firmwareUpdateCurrentBytes = currentBytes;
 }
+
+void Ble::NotifyChange() {
+  if (changeListener != nullptr) {
+    changeListener->OnChange(ChangeEvents::Ble);
+  }
+}
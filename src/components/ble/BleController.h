@@ -2,6 +2,7 @@
 
 #include <array>
 #include <cstdint>
+#include "components/ChangeListener.h"
 
 namespace Pinetime {
   namespace Controllers {
@@ -65,6 +66,10 @@ namespace Pinetime {
         return pairingKey;
       }
 
+      void SetChangeListener(ChangeListener* listener) {
+        changeListener = listener;
+      }
+
     private:
       bool isConnected = false;
       bool isRadioEnabled = true;
@@ -75,6 +80,9 @@ namespace Pinetime {
       BleAddress address;
       AddressTypes addressType;
       uint32_t pairingKey = 0;
+      ChangeListener* changeListener = nullptr;
+
+      void NotifyChange();
     };
   }
 }
@@ -0,0 +1,63 @@
+#include "components/ble/FrameProfilerService.h"
+#include "components/profiler/FrameProfiler.h"
+
+using namespace Pinetime::Controllers;
+
+namespace {
+  // 0006yyxx-78fc-48fe-8e23-433b3a1942d0
+  constexpr ble_uuid128_t CharUuid(uint8_t x, uint8_t y) {
+    return ble_uuid128_t {.u = {.type = BLE_UUID_TYPE_128},
+                          .value = {0xd0, 0x42, 0x19, 0x3a, 0x3b, 0x43, 0x23, 0x8e, 0xfe, 0x48, 0xfc, 0x78, x, y, 0x06, 0x00}};
+  }
+
+  // 00060000-78fc-48fe-8e23-433b3a1942d0
+  constexpr ble_uuid128_t BaseUuid() {
+    return CharUuid(0x00, 0x00);
+  }
+
+  constexpr ble_uuid128_t frameProfilerServiceUuid {BaseUuid()};
+  constexpr ble_uuid128_t framesCharUuid {CharUuid(0x01, 0x00)};
+
+  int FrameProfilerServiceCallback(uint16_t /*conn_handle*/, uint16_t attr_handle, struct ble_gatt_access_ctxt* ctxt, void* arg) {
+    auto* frameProfilerService = static_cast<FrameProfilerService*>(arg);
+    return frameProfilerService->OnFramesRequested(attr_handle, ctxt);
+  }
+}
+
+FrameProfilerService::FrameProfilerService()
+  : characteristicDefinition {{.uuid = &framesCharUuid.u,
+                               .access_cb = FrameProfilerServiceCallback,
+                               .arg = this,
+                               .flags = BLE_GATT_CHR_F_READ,
+                               .val_handle = &framesHandle},
+                              {0}},
+    serviceDefinition {
+      {.type = BLE_GATT_SVC_TYPE_PRIMARY, .uuid = &frameProfilerServiceUuid.u, .characteristics = characteristicDefinition},
+      {0},
+    } {
+}
+
+void FrameProfilerService::Init() {
+  int res = 0;
+  res = ble_gatts_count_cfg(serviceDefinition);
+  ASSERT(res == 0);
+
+  res = ble_gatts_add_svcs(serviceDefinition);
+  ASSERT(res == 0);
+}
+
+int FrameProfilerService::OnFramesRequested(uint16_t attributeHandle, ble_gatt_access_ctxt* context) {
+  if (attributeHandle != framesHandle || frameProfiler == nullptr) {
+    return 0;
+  }
+
+  // Each frame is sent as 4 little-endian uint32: render time, flush time and SPI wait time in us, and bytes sent.
+  // The display task is not stopped while the frames are read, so the last frame may be overwritten meanwhile.
+  for (size_t nbFramesAgo = frameProfiler->NbFrames(); nbFramesAgo > 0; nbFramesAgo--) {
+    const FrameProfiler::Frame frame = frameProfiler->GetFrame(nbFramesAgo - 1);
+    if (os_mbuf_append(context->om, &frame, sizeof(frame)) != 0) {
+      return BLE_ATT_ERR_INSUFFICIENT_RES;
+    }
+  }
+  return 0;
+}
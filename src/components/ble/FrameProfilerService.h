@@ -0,0 +1,32 @@
+#pragma once
+#define min // workaround: nimble's min/max macros conflict with libstdc++
+#define max
+#include <host/ble_gap.h>
+#undef max
+#undef min
+
+namespace Pinetime {
+  namespace Controllers {
+    class FrameProfiler;
+
+    // Exposes the frames recorded by the FrameProfiler of the display, oldest first
+    class FrameProfilerService {
+    public:
+      FrameProfilerService();
+      void Init();
+      int OnFramesRequested(uint16_t attributeHandle, ble_gatt_access_ctxt* context);
+
+      void SetFrameProfiler(const FrameProfiler* frameProfiler) {
+        this->frameProfiler = frameProfiler;
+      }
+
+    private:
+      const FrameProfiler* frameProfiler = nullptr;
+
+      struct ble_gatt_chr_def characteristicDefinition[2];
+      struct ble_gatt_svc_def serviceDefinition[2];
+
+      uint16_t framesHandle;
+    };
+  }
+}
@@ -0,0 +1,199 @@
+#include "components/ble/HistoryService.h"
+#include <algorithm>
+#include <limits>
+#include <nimble/nimble_port.h>
+#include <nrf_log.h>
+#include "systemtask/SystemTask.h"
+
+using namespace Pinetime::Controllers;
+
+namespace {
+  // 0007yyxx-78fc-48fe-8e23-433b3a1942d0
+  constexpr ble_uuid128_t CharUuid(uint8_t x, uint8_t y) {
+    return ble_uuid128_t {.u = {.type = BLE_UUID_TYPE_128},
+                          .value = {0xd0, 0x42, 0x19, 0x3a, 0x3b, 0x43, 0x23, 0x8e, 0xfe, 0x48, 0xfc, 0x78, x, y, 0x07, 0x00}};
+  }
+
+  // 00070000-78fc-48fe-8e23-433b3a1942d0
+  constexpr ble_uuid128_t BaseUuid() {
+    return CharUuid(0x00, 0x00);
+  }
+
+  constexpr ble_uuid128_t historyServiceUuid {BaseUuid()};
+  constexpr ble_uuid128_t syncCharUuid {CharUuid(0x01, 0x00)};
+
+  constexpr size_t requestSize = 5;
+
+  int HistoryServiceCallback(uint16_t conn_handle, uint16_t attr_handle, struct ble_gatt_access_ctxt* ctxt, void* arg) {
+    auto* historyService = static_cast<HistoryService*>(arg);
+    return historyService->OnSyncRequested(conn_handle, attr_handle, ctxt);
+  }
+
+  void BatchCalloutCallback(ble_npl_event* event) {
+    auto* historyService = static_cast<HistoryService*>(ble_npl_event_get_arg(event));
+    historyService->SendNotifications();
+  }
+}
+
+HistoryService::HistoryService(Pinetime::System::SystemTask& systemTask, HistoryController& historyController)
+  : systemTask {systemTask},
+    historyController {historyController},
+    characteristicDefinition {{.uuid = &syncCharUuid.u,
+                               .access_cb = HistoryServiceCallback,
+                               .arg = this,
+                               .flags = BLE_GATT_CHR_F_WRITE | BLE_GATT_CHR_F_NOTIFY,
+                               .val_handle = &syncHandle},
+                              {0}},
+    serviceDefinition {
+      {.type = BLE_GATT_SVC_TYPE_PRIMARY, .uuid = &historyServiceUuid.u, .characteristics = characteristicDefinition},
+      {0},
+    } {
+}
+
+void HistoryService::Init() {
+  int res = 0;
+  res = ble_gatts_count_cfg(serviceDefinition);
+  ASSERT(res == 0);
+
+  res = ble_gatts_add_svcs(serviceDefinition);
+  ASSERT(res == 0);
+
+  ble_npl_callout_init(&batchCallout, nimble_port_get_dflt_eventq(), BatchCalloutCallback, this);
+}
+
+int HistoryService::OnSyncRequested(uint16_t connectionHandle, uint16_t attributeHandle, ble_gatt_access_ctxt* context) {
+  if (attributeHandle != syncHandle || context->op != BLE_GATT_ACCESS_OP_WRITE_CHR) {
+    return 0;
+  }
+
+  uint8_t request[requestSize];
+  if (OS_MBUF_PKTLEN(context->om) != requestSize || os_mbuf_copydata(context->om, 0, requestSize, request) != 0) {
+    return BLE_ATT_ERR_INVALID_ATTR_VALUE_LEN;
+  }
+  if (request[0] > static_cast<uint8_t>(HistoryController::Series::Steps)) {
+    return BLE_ATT_ERR_REQ_NOT_SUPPORTED;
+  }
+  if (!isSubscribed) {
+    return BLE_ATT_ERR_UNLIKELY;
+  }
+  auto requestedSeries = static_cast<HistoryController::Series>(request[0]);
+  uint32_t requestedFrom = request[1] | (request[2] << 8) | (request[3] << 16) | (static_cast<uint32_t>(request[4]) << 24);
+  NRF_LOG_INFO("[History] Sync series %d from %lu", request[0], requestedFrom);
+
+  if (!isSyncing) {
+    // The history is read from the external flash, which is asleep while the watch is sleeping
+    systemTask.PushMessage(Pinetime::System::Messages::StartFileTransfer);
+    vTaskDelay(10);
+    while (systemTask.IsSleeping()) {
+      vTaskDelay(100);
+    }
+    isSyncing = true;
+  }
+
+  // A new request replaces the current one, the notifications already handed to the stack are still sent
+  this->connectionHandle = connectionHandle;
+  series = requestedSeries;
+  from = requestedFrom;
+  isEndReached = false;
+  isComplete = false;
+  SendNotifications();
+  return 0;
+}
+
+void HistoryService::SendNotifications() {
+  for (uint8_t idx = 0; idx < maxNotificationsPerBatch && isSyncing && !isComplete && os_msys_num_free() >= minFreeMbufs; idx++) {
+    if (!SendNotification()) {
+      break;
+    }
+  }
+  if (!isSyncing) {
+    return;
+  }
+  if (isComplete) {
+    StopSync();
+    return;
+  }
+  ble_npl_callout_reset(&batchCallout, ble_npl_time_ms_to_ticks32(batchPeriodMs));
+}
+
+// Returns false if the notification could not be queued. It is retried with the next batch when the stack ran out of memory.
+bool HistoryService::SendNotification() {
+  uint16_t mtu = ble_att_mtu(connectionHandle);
+  if (mtu == 0) {
+    StopSync();
+    return false;
+  }
+  size_t maxSamples = std::min(maxSamplesPerNotification, (mtu - 3 - headerSize) / sampleSize);
+
+  size_t nbSamples = 0;
+  if (!isEndReached) {
+    nbSamples = historyController.Query(series, from, std::numeric_limits<uint32_t>::max(), {samples.data(), maxSamples});
+  }
+
+  // Each sample is a little-endian uint32 timestamp followed by a little-endian uint16 value
+  auto header = static_cast<uint8_t>(series);
+  auto* om = ble_hs_mbuf_from_flat(&header, headerSize);
+  for (size_t idx = 0; idx < nbSamples && om != nullptr; idx++) {
+    uint32_t value = std::min(samples[idx].value, static_cast<uint32_t>(std::numeric_limits<uint16_t>::max()));
+    uint8_t sample[sampleSize] = {static_cast<uint8_t>(samples[idx].timestamp),
+                                  static_cast<uint8_t>(samples[idx].timestamp >> 8),
+                                  static_cast<uint8_t>(samples[idx].timestamp >> 16),
+                                  static_cast<uint8_t>(samples[idx].timestamp >> 24),
+                                  static_cast<uint8_t>(value),
+                                  static_cast<uint8_t>(value >> 8)};
+    if (os_mbuf_append(om, sample, sampleSize) != 0) {
+      os_mbuf_free_chain(om);
+      om = nullptr;
+    }
+  }
+  if (om == nullptr) {
+    return false;
+  }
+
+  // The progress is updated before the notification is queued, ble_gattc_notify_custom() runs the GAP callbacks before returning.
+  // The last notification of a sync has no sample.
+  uint32_t previousFrom = from;
+  bool wasEndReached = isEndReached;
+  if (nbSamples == 0) {
+    isComplete = true;
+  } else {
+    from = samples[nbSamples - 1].timestamp + 1;
+    isEndReached = nbSamples < maxSamples;
+  }
+
+  int res = ble_gattc_notify_custom(connectionHandle, syncHandle, om);
+  if (res == BLE_HS_ENOMEM) {
+    from = previousFrom;
+    isEndReached = wasEndReached;
+    isComplete = false;
+    return false;
+  }
+  if (res != 0) {
+    // The client can resume the sync from the last sample it received
+    StopSync();
+    return false;
+  }
+  return true;
+}
+
+void HistoryService::SubscribeNotification(uint16_t attributeHandle) {
+  if (attributeHandle == syncHandle) {
+    isSubscribed = true;
+  }
+}
+
+void HistoryService::UnsubscribeNotification(uint16_t attributeHandle) {
+  if (attributeHandle == syncHandle) {
+    isSubscribed = false;
+    StopSync();
+  }
+}
+
+void HistoryService::StopSync() {
+  if (!isSyncing) {
+    return;
+  }
+  isSyncing = false;
+  ble_npl_callout_stop(&batchCallout);
+  systemTask.PushMessage(Pinetime::System::Messages::StopFileTransfer);
+}
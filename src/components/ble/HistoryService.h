@@ -0,0 +1,61 @@
+#pragma once
+#include <array>
+#define min // workaround: nimble's min/max macros conflict with libstdc++
+#define max
+#include <host/ble_gap.h>
+#undef max
+#undef min
+
+#include "components/history/HistoryController.h"
+
+namespace Pinetime {
+  namespace System {
+    class SystemTask;
+  }
+
+  namespace Controllers {
+    // Streams the samples stored by the HistoryController, see doc/HistoryService.md for the protocol
+    class HistoryService {
+    public:
+      HistoryService(Pinetime::System::SystemTask& systemTask, HistoryController& historyController);
+      void Init();
+      int OnSyncRequested(uint16_t connectionHandle, uint16_t attributeHandle, ble_gatt_access_ctxt* context);
+      void SendNotifications();
+
+      void SubscribeNotification(uint16_t attributeHandle);
+      void UnsubscribeNotification(uint16_t attributeHandle);
+      void StopSync();
+
+    private:
+      static constexpr size_t headerSize = 1;
+      static constexpr size_t sampleSize = 6;
+      static constexpr size_t maxSamplesPerNotification = (MYNEWT_VAL(BLE_ATT_PREFERRED_MTU) - 3 - headerSize) / sampleSize;
+      // The notifications are queued in batches, as long as enough mbufs are left to the other services.
+      // The next batch is queued by a callout, once the stack had the time to send the previous ones.
+      static constexpr uint8_t maxNotificationsPerBatch = 3;
+      static constexpr int minFreeMbufs = 6;
+      static constexpr uint32_t batchPeriodMs = 30;
+
+      Pinetime::System::SystemTask& systemTask;
+      HistoryController& historyController;
+
+      struct ble_gatt_chr_def characteristicDefinition[2];
+      struct ble_gatt_svc_def serviceDefinition[2];
+
+      uint16_t syncHandle;
+      bool isSubscribed = false;
+
+      // Only accessed from the BLE host task
+      bool isSyncing = false;
+      bool isEndReached = false;
+      bool isComplete = false;
+      uint16_t connectionHandle;
+      HistoryController::Series series;
+      uint32_t from;
+      std::array<HistoryController::Sample, maxSamplesPerNotification> samples;
+      ble_npl_callout batchCallout;
+
+      bool SendNotification();
+    };
+  }
+}
@@ -15,7 +15,9 @@
 #include "components/ble/DeviceInformationService.h"
 #include "components/ble/DfuService.h"
 #include "components/ble/FSService.h"
+#include "components/ble/FrameProfilerService.h"
 #include "components/ble/HeartRateService.h"
+#include "components/ble/HistoryService.h"
 #include "components/ble/ImmediateAlertService.h"
 #include "components/ble/MusicService.h"
 #include "components/ble/NavigationService.h"
@@ -49,7 +51,8 @@ namespace Pinetime {
                        Pinetime::Drivers::SpiNorFlash& spiNorFlash,
                        HeartRateController& heartRateController,
                        MotionController& motionController,
-                       FS& fs);
+                       FS& fs,
+                       HistoryController& historyController);
       void Init();
       void StartAdvertising();
       int OnGAPEvent(ble_gap_event* event);
@@ -71,6 +74,10 @@ namespace Pinetime {
         return weatherService;
       };
 
+      Pinetime::Controllers::FrameProfilerService& frameProfiler() {
+        return frameProfilerService;
+      };
+
       uint16_t connHandle();
       void NotifyBatteryLevel(uint8_t level);
 
@@ -106,6 +113,8 @@ namespace Pinetime {
       HeartRateService heartRateService;
       MotionService motionService;
       FSService fsService;
+      HistoryService historyService;
+      FrameProfilerService frameProfilerService;
       ServiceDiscovery serviceDiscovery;
 
       uint8_t addrType;
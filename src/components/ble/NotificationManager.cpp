@@ -21,6 +21,9 @@ void NotificationManager::Push(NotificationManager::Notification&& notif) {
   if (size < notifications.size()) {
     size++;
   }
+  if (changeListener != nullptr) {
+    changeListener->OnChange(ChangeEvents::Notification);
+  }
 }
 
 NotificationManager::Notification::Id NotificationManager::GetNextId() {
@@ -133,7 +136,11 @@ bool NotificationManager::AreNewNotificationsAvailable() const {
 }
 
 bool NotificationManager::ClearNewNotificationFlag() {
-  return newNotification.exchange(false);
+  const bool hadNewNotification = newNotification.exchange(false);
+  if (hadNewNotification && changeListener != nullptr) {
+    changeListener->OnChange(ChangeEvents::Notification);
+  }
+  return hadNewNotification;
 }
 
 size_t NotificationManager::NbNotifications() const {
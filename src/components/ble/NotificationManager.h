@@ -6,6 +6,7 @@
 #include <cstdint>
 #include <chrono>
 #include "components/datetime/DateTimeController.h"
+#include "components/ChangeListener.h"
 
 namespace Pinetime {
   namespace Controllers {
@@ -67,6 +68,10 @@ namespace Pinetime {
 
       size_t NbNotifications() const;
 
+      void SetChangeListener(ChangeListener* listener) {
+        changeListener = listener;
+      }
+
     private:
       const Controllers::DateTime& dateTimeController;
       Notification::Id nextId {0};
@@ -81,6 +86,7 @@ namespace Pinetime {
       size_t size = 0;                            // number of valid notifications in buffer
 
       std::atomic<bool> newNotification {false};
+      ChangeListener* changeListener = nullptr;
     };
   }
 }
@@ -103,6 +103,9 @@ int SimpleWeatherService::OnCommand(struct ble_gatt_access_ctxt* ctxt) {
                      currentWeather->maxTemperature,
                      currentWeather->iconId,
                      currentWeather->location.data());
+        if (changeListener != nullptr) {
+          changeListener->OnChange(ChangeEvents::Weather);
+        }
       }
       break;
     case MessageType::Forecast:
@@ -116,6 +119,9 @@ int SimpleWeatherService::OnCommand(struct ble_gatt_access_ctxt* ctxt) {
                        forecast->days[i].maxTemperature,
                        forecast->days[i].iconId);
         }
+        if (changeListener != nullptr) {
+          changeListener->OnChange(ChangeEvents::Weather);
+        }
       }
       break;
     default:
@@ -32,6 +32,7 @@
 #undef min
 
 #include "components/datetime/DateTimeController.h"
+#include "components/ChangeListener.h"
 
 int WeatherCallback(uint16_t connHandle, uint16_t attrHandle, struct ble_gatt_access_ctxt* ctxt, void* arg);
 
@@ -108,6 +109,10 @@ namespace Pinetime {
       std::optional<CurrentWeather> Current() const;
       std::optional<Forecast> GetForecast() const;
 
+      void SetChangeListener(ChangeListener* listener) {
+        changeListener = listener;
+      }
+
       static int16_t CelsiusToFahrenheit(int16_t celsius) {
         return celsius * 9 / 5 + 3200;
       }
@@ -144,6 +149,8 @@ namespace Pinetime {
 
       std::optional<CurrentWeather> currentWeather;
       std::optional<Forecast> forecast;
+
+      ChangeListener* changeListener = nullptr;
     };
   }
 }
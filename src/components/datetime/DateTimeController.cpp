@@ -72,6 +72,14 @@ void DateTime::UpdateTime(uint32_t systickCounter) {
   std::time_t currentTime = std::chrono::system_clock::to_time_t(currentDateTime);
   localTime = *std::localtime(&currentTime);
 
+  if (changeListener != nullptr && currentTime != lastChangeTime) {
+    if (currentTime / 60 != lastChangeTime / 60) {
+      changeListener->OnChange(ChangeEvents::Minute);
+    }
+    changeListener->OnChange(ChangeEvents::Second);
+    lastChangeTime = currentTime;
+  }
+
   auto minute = Minutes();
   auto hour = Hours();
 
@@ -129,6 +137,10 @@ const char* DateTime::DayOfWeekShortToStringLow() const {
   return DaysStringShortLow[static_cast<uint8_t>(DayOfWeek())];
 }
 
+void DateTime::SetChangeListener(ChangeListener* listener) {
+  changeListener = listener;
+}
+
 void DateTime::Register(Pinetime::System::SystemTask* systemTask) {
   this->systemTask = systemTask;
 }
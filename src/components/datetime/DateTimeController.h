@@ -5,6 +5,7 @@
 #include <ctime>
 #include <string>
 #include "components/settings/Settings.h"
+#include "components/ChangeListener.h"
 
 namespace Pinetime {
   namespace System {
@@ -137,6 +138,7 @@ namespace Pinetime {
       }
 
       void Register(System::SystemTask* systemTask);
+      void SetChangeListener(ChangeListener* listener);
       void SetCurrentTime(std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> t);
       std::string FormattedTime();
 
@@ -153,6 +155,8 @@ namespace Pinetime {
       bool isHourAlreadyNotified = true;
       bool isHalfHourAlreadyNotified = true;
       System::SystemTask* systemTask = nullptr;
+      ChangeListener* changeListener = nullptr;
+      std::time_t lastChangeTime = 0;
       Controllers::Settings& settingsController;
     };
   }
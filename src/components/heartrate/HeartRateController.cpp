@@ -5,17 +5,24 @@
 using namespace Pinetime::Controllers;
 
 void HeartRateController::Update(HeartRateController::States newState, uint8_t heartRate) {
+  const bool changed = this->state != newState || this->heartRate != heartRate;
   this->state = newState;
   if (this->heartRate != heartRate) {
     this->heartRate = heartRate;
     service->OnNewHeartRateValue(heartRate);
   }
+  if (changed && changeListener != nullptr) {
+    changeListener->OnChange(ChangeEvents::HeartRate);
+  }
 }
 
 void HeartRateController::Start() {
   if (task != nullptr) {
     state = States::NotEnoughData;
     task->PushMessage(Pinetime::Applications::HeartRateTask::Messages::StartMeasurement);
+    if (changeListener != nullptr) {
+      changeListener->OnChange(ChangeEvents::HeartRate);
+    }
   }
 }
 
@@ -23,6 +30,9 @@ void HeartRateController::Stop() {
   if (task != nullptr) {
     state = States::Stopped;
     task->PushMessage(Pinetime::Applications::HeartRateTask::Messages::StopMeasurement);
+    if (changeListener != nullptr) {
+      changeListener->OnChange(ChangeEvents::HeartRate);
+    }
   }
 }
 
@@ -33,3 +43,7 @@ void HeartRateController::SetHeartRateTask(Pinetime::Applications::HeartRateTask
 void HeartRateController::SetService(Pinetime::Controllers::HeartRateService* service) {
   this->service = service;
 }
+
+void HeartRateController::SetChangeListener(ChangeListener* listener) {
+  changeListener = listener;
+}
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <components/ble/HeartRateService.h>
+#include "components/ChangeListener.h"
 
 namespace Pinetime {
   namespace Applications {
@@ -33,12 +34,14 @@ namespace Pinetime {
       }
 
       void SetService(Pinetime::Controllers::HeartRateService* service);
+      void SetChangeListener(ChangeListener* listener);
 
     private:
       Applications::HeartRateTask* task = nullptr;
       States state = States::Stopped;
       uint8_t heartRate = 0;
       Pinetime::Controllers::HeartRateService* service = nullptr;
+      ChangeListener* changeListener = nullptr;
     };
   }
 }
\ No newline at end of file
@@ -1,56 +1,34 @@
 #include "components/heartrate/Ppg.h"
 #include <nrf_log.h>
 #include <vector>
+#include <algorithm>
+#include <cmath>
 
 using namespace Pinetime::Controllers;
 
 namespace {
-  float LinearInterpolation(const float* xValues, const float* yValues, int length, float pointX) {
-    if (pointX > xValues[length - 1]) {
-      return yValues[length - 1];
-    } else if (pointX <= xValues[0]) {
-      return yValues[0];
-    }
-    int index = 0;
-    while (pointX > xValues[index] && index < length - 1) {
-      index++;
-    }
-    float pointX0 = xValues[index - 1];
-    float pointX1 = xValues[index];
-    float pointY0 = yValues[index - 1];
-    float pointY1 = yValues[index];
-    float mu = (pointX - pointX0) / (pointX1 - pointX0);
-
-    return (pointY0 * (1 - mu) + pointY1 * mu);
-  }
-
-  float PeakSearch(float* xVals, float* yVals, float threshold, float& width, float start, float end, int length) {
+  // Searches the piecewise linear interpolation of values for a single region above threshold in [start, end).
+  // The threshold crossings are computed analytically, so the whole search is one pass over the bins.
+  // Returns the center of the region and its width (bins), or 0 when there isn't exactly one region.
+  float PeakSearch(const float* values, float threshold, float& width, int start, int end) {
     int peaks = 0;
     bool enabled = false;
     float minBin = 0.0f;
-    float maxBin = 0.0f;
     float peakCenter = 0.0f;
-    float prevValue = LinearInterpolation(xVals, yVals, length, start - 0.01f);
-    float currValue = LinearInterpolation(xVals, yVals, length, start);
-    float idx = start;
-    while (idx < end) {
-      float nextValue = LinearInterpolation(xVals, yVals, length, idx + 0.01f);
+    for (int idx = start; idx < end; idx++) {
+      float currValue = values[idx];
+      float nextValue = values[idx + 1];
       if (currValue < threshold) {
         enabled = true;
-      }
-      if (currValue >= threshold and enabled) {
-        if (prevValue < threshold) {
-          minBin = idx;
-        } else if (nextValue <= threshold) {
-          maxBin = idx;
-          peaks++;
-          width = maxBin - minBin;
-          peakCenter = width / 2.0f + minBin;
+        if (nextValue >= threshold) {
+          minBin = static_cast<float>(idx) + (threshold - currValue) / (nextValue - currValue);
         }
+      } else if (enabled && nextValue < threshold) {
+        float maxBin = static_cast<float>(idx) + (currValue - threshold) / (currValue - nextValue);
+        peaks++;
+        width = maxBin - minBin;
+        peakCenter = width / 2.0f + minBin;
       }
-      prevValue = currValue;
-      currValue = nextValue;
-      idx += 0.01f;
     }
     if (peaks != 1) {
       width = 0.0f;
@@ -77,6 +55,7 @@ namespace {
     return max / mean;
   }
 
+#ifndef PPG_FIXED_POINT
   // Simple bandpass filter using exponential moving average
   void Filter30to240(std::array<float, Ppg::dataLength>& signal) {
     // From:
@@ -102,6 +81,7 @@ namespace {
       }
     }
   }
+#endif
 
   float SpectrumMax(const std::array<float, Ppg::spectrumLength>& data, int start, int end) {
     float max = 0.0f;
@@ -113,6 +93,106 @@ namespace {
     return max;
   }
 
+#ifdef PPG_FIXED_POINT
+  void Detrend(std::array<int32_t, Ppg::dataLength>& signal) {
+    int size = signal.size();
+    int32_t offset = signal.front();
+    int32_t delta = signal.at(size - 1) - offset;
+
+    for (int idx = 0; idx < size; idx++) {
+      signal[idx] -= static_cast<int32_t>((static_cast<int64_t>(delta) * idx) / (size - 1)) + offset;
+    }
+    for (int idx = 0; idx < size - 1; idx++) {
+      signal[idx] = signal[idx + 1] - signal[idx];
+    }
+  }
+
+  // Same exponential moving average bandpass as the floating point version, coefficients in Q15
+  void Filter30to240(std::array<int32_t, Ppg::dataLength>& signal) {
+    constexpr int64_t one = 1 << 15;
+    // 8782 (0.268) is ~0.5Hz and 26739 (0.816) is ~4Hz cutoff at 10Hz sampling
+    int64_t expAlpha = 26739;
+    int64_t expAvg = 0;
+    for (int loop = 0; loop < 4; loop++) {
+      expAvg = signal.front();
+      for (auto& value : signal) {
+        expAvg = (expAlpha * value + (one - expAlpha) * expAvg) >> 15;
+        value = static_cast<int32_t>(expAvg);
+      }
+    }
+    expAlpha = 8782;
+    for (int loop = 0; loop < 4; loop++) {
+      expAvg = signal.front();
+      for (auto& value : signal) {
+        expAvg = (expAlpha * value + (one - expAlpha) * expAvg) >> 15;
+        value -= static_cast<int32_t>(expAvg);
+      }
+    }
+  }
+
+  uint32_t SquareRoot(uint64_t value) {
+    uint64_t result = 0;
+    uint64_t bit = uint64_t {1} << 62;
+    while (bit > value) {
+      bit >>= 2;
+    }
+    while (bit != 0) {
+      if (value >= result + bit) {
+        value -= result + bit;
+        result = (result >> 1) + bit;
+      } else {
+        result >>= 1;
+      }
+      bit >>= 2;
+    }
+    return static_cast<uint32_t>(result);
+  }
+
+  // cos(2 * pi * k / dataLength) in Q15 for k in [0, dataLength / 2).
+  // sin(2 * pi * k / dataLength) is read from the same table at |k - dataLength / 4|.
+  // Note: Harcoded and must be updated if constexpr dataLength is changed.
+  constexpr int16_t cosine[Ppg::dataLength >> 1] {
+    32767,  32609,  32137,  31356,  30273,  28898,  27245,  25329,  23170,  20787,  18204,
+    15446,  12539,  9512,   6393,   3212,   0,      -3212,  -6393,  -9512,  -12539, -15446,
+    -18204, -20787, -23170, -25329, -27245, -28898, -30273, -31356, -32137, -32609};
+
+  // In place radix-2 decimation in time FFT on Q-format integers.
+  // Twiddle factors are Q15 and magnitudes only grow by dataLength, so no per-stage scaling is needed
+  // as long as the input stays below 2^(31 - log2(dataLength)).
+  void ComputeFFT(std::array<int32_t, Ppg::dataLength>& real, std::array<int32_t, Ppg::dataLength>& imag) {
+    constexpr int length = Ppg::dataLength;
+    // Bit reversal
+    for (int idx = 1, rev = 0; idx < length; idx++) {
+      int bit = length >> 1;
+      for (; rev & bit; bit >>= 1) {
+        rev ^= bit;
+      }
+      rev ^= bit;
+      if (idx < rev) {
+        std::swap(real[idx], real[rev]);
+        std::swap(imag[idx], imag[rev]);
+      }
+    }
+    for (int span = 1; span < length; span <<= 1) {
+      int step = length / (span << 1);
+      for (int group = 0; group < length; group += span << 1) {
+        for (int pair = 0; pair < span; pair++) {
+          int k = pair * step;
+          int64_t wr = cosine[k];
+          int64_t wi = -cosine[k >= length / 4 ? k - length / 4 : length / 4 - k];
+          int even = group + pair;
+          int odd = even + span;
+          int32_t tr = static_cast<int32_t>((wr * real[odd] - wi * imag[odd]) >> 15);
+          int32_t ti = static_cast<int32_t>((wr * imag[odd] + wi * real[odd]) >> 15);
+          real[odd] = real[even] - tr;
+          imag[odd] = imag[even] - ti;
+          real[even] += tr;
+          imag[even] += ti;
+        }
+      }
+    }
+  }
+#else
   void Detrend(std::array<float, Ppg::dataLength>& signal) {
     int size = signal.size();
     float offset = signal.front();
@@ -125,6 +205,7 @@ namespace {
       signal[idx] = signal[idx + 1] - signal[idx];
     }
   }
+#endif
 
   // Hanning Coefficients from numpy: python -c 'import numpy;print(numpy.hanning(64))'
   // Note: Harcoded and must be updated if constexpr dataLength is changed. Prevents the need to
@@ -135,15 +216,62 @@ namespace {
     0.15088159f, 0.1882551f,  0.22872687f, 0.27189467f, 0.31732949f, 0.36457977f, 0.41317591f, 0.46263495f,
     0.51246535f, 0.56217185f, 0.61126047f, 0.65924333f, 0.70564355f, 0.75f,       0.79187184f, 0.83084292f,
     0.86652594f, 0.89856625f, 0.92664544f, 0.95048443f, 0.96984631f, 0.98453864f, 0.99441541f, 0.99937846f};
+
+  // cos(2 * pi * k / dataLength) for k in [0, dataLength / 4]
+  // Note: Harcoded and must be updated if constexpr dataLength is changed.
+  constexpr float quarterCosine[(Ppg::dataLength >> 2) + 1] {
+    1.0f,        0.99518473f, 0.98078528f, 0.95694034f, 0.92387953f, 0.88192126f, 0.83146961f, 0.77301045f, 0.70710678f,
+    0.63439328f, 0.55557023f, 0.47139674f, 0.38268343f, 0.29028468f, 0.19509032f, 0.09801714f, 0.0f};
+
+  // cos(2 * pi * k / dataLength) for any k in [0, dataLength / 2]
+  constexpr float Cosine(int k) {
+    constexpr int quarter = Ppg::dataLength >> 2;
+    return k <= quarter ? quarterCosine[k] : -quarterCosine[2 * quarter - k];
+  }
+
+  // sin(2 * pi * k / dataLength) for any k in [0, dataLength / 2]
+  constexpr float Sine(int k) {
+    constexpr int quarter = Ppg::dataLength >> 2;
+    return k <= quarter ? quarterCosine[quarter - k] : quarterCosine[k - quarter];
+  }
+
+  // Slightly damps the sliding DFT so that rounding errors don't accumulate forever
+  constexpr float slidingDamping = 0.9999f;
+  constexpr float slidingDampingN = [] {
+    float value = 1.0f;
+    for (int idx = 0; idx < Ppg::dataLength; idx++) {
+      value *= slidingDamping;
+    }
+    return value;
+  }();
+
+#ifdef PPG_FIXED_POINT
+  // Same coefficients in Q15, converted at compile time
+  constexpr auto hanningQ15 = [] {
+    std::array<int32_t, Ppg::dataLength / 2> table {};
+    for (size_t idx = 0; idx < table.size(); idx++) {
+      table[idx] = static_cast<int32_t>(hanning[idx] * 32767.0f + 0.5f);
+    }
+    return table;
+  }();
+#endif
 }
 
 Ppg::Ppg() {
   dataAverage.fill(0.0f);
   spectrum.fill(0.0f);
+  ResetSlidingSpectrum();
 }
 
-int8_t Ppg::Preprocess(uint32_t hrs, uint32_t als) {
-  if (dataIndex < dataLength) {
+int8_t Ppg::Preprocess(uint32_t hrs, uint32_t als, int32_t motion) {
+  dataMotion[motionIndex] = static_cast<int16_t>(std::min<int32_t>(motion, INT16_MAX));
+  motionIndex = (motionIndex + 1) % dataLength;
+  if (motionCount < dataLength) {
+    motionCount++;
+  }
+  if (incremental) {
+    SlideSpectrum(hrs);
+  } else if (dataIndex < dataLength) {
     dataHRS[dataIndex++] = hrs;
   }
   alsValue = als;
@@ -154,6 +282,16 @@ int8_t Ppg::Preprocess(uint32_t hrs, uint32_t als) {
 }
 
 int Ppg::HeartRate() {
+  isNewAnalysis = false;
+  if (incremental) {
+    if (filteredCount < dataLength || newSamples < overlapWindow) {
+      return 0;
+    }
+    newSamples = 0;
+    int hr = ProcessHeartRate(resetSpectralAvg);
+    resetSpectralAvg = false;
+    return hr;
+  }
   if (dataIndex < dataLength) {
     return 0;
   }
@@ -171,6 +309,9 @@ int Ppg::HeartRate() {
 void Ppg::Reset(bool resetDaqBuffer) {
   if (resetDaqBuffer) {
     dataIndex = 0;
+    motionIndex = 0;
+    motionCount = 0;
+    ResetSlidingSpectrum();
   }
   avgIndex = 0;
   dataAverage.fill(0.0f);
@@ -181,49 +322,47 @@ void Ppg::Reset(bool resetDaqBuffer) {
   spectrum.fill(0.0f);
 }
 
+void Ppg::SetIncremental(bool enabled) {
+  if (enabled != incremental) {
+    incremental = enabled;
+    Reset(true);
+  }
+}
+
 // Pass init == true to reset spectral averaging.
 // Returns -1 (Reset Acquisition), 0 (Unable to obtain HR) or HR (BPM).
 int Ppg::ProcessHeartRate(bool init) {
-  std::copy(dataHRS.begin(), dataHRS.end(), vReal.begin());
-  Detrend(vReal);
-  Filter30to240(vReal);
-  vImag.fill(0.0f);
-  // Apply Hanning Window
-  int hannIdx = 0;
-  for (int idx = 0; idx < dataLength; idx++) {
-    if (idx >= dataLength >> 1) {
-      hannIdx--;
-    }
-    vReal[idx] *= hanning[hannIdx];
-    if (idx < dataLength >> 1) {
-      hannIdx++;
-    }
+  std::array<float, spectrumLength> magnitudes;
+  if (incremental) {
+    SlidingMagnitudes(magnitudes);
+  } else {
+    ComputeSpectrum(magnitudes);
+  }
+  SpectrumAverage(magnitudes.data(), spectrum.data(), spectrum.size(), init);
+  // Reuse magnitudes for the averaged spectrum without the bins where the wrist is moving periodically,
+  // so that the cadence of a walk isn't mistaken for the heart rate
+  uint32_t motionPeaks = MotionPeaks();
+  // A peak also leaks in the neighbouring bins
+  uint32_t maskedBins = motionPeaks | (motionPeaks << 1) | (motionPeaks >> 1);
+  for (int idx = 0; idx < spectrumLength; idx++) {
+    magnitudes[idx] = (maskedBins & (1u << idx)) != 0 ? 0.0f : spectrum[idx];
   }
-  // Compute in place power spectrum
-  ArduinoFFT<float> FFT = ArduinoFFT<float>(vReal.data(), vImag.data(), dataLength, sampleFreq);
-  FFT.compute(FFTDirection::Forward);
-  FFT.complexToMagnitude();
-  FFT.~ArduinoFFT();
-  SpectrumAverage(vReal.data(), spectrum.data(), spectrum.size(), init);
   peakLocation = 0.0f;
   float threshold = peakDetectionThreshold;
   float peakWidth = 0.0f;
-  int specLen = spectrum.size();
-  float max = SpectrumMax(spectrum, hrROIbegin, hrROIend);
-  float signalToNoiseRatio = SignalToNoise(spectrum, hrROIbegin, hrROIend, max);
-  if (signalToNoiseRatio > signalToNoiseThreshold && spectrum.at(0) < dcThreshold) {
+  float max = SpectrumMax(magnitudes, hrROIbegin, hrROIend);
+  float signalToNoiseRatio = SignalToNoise(magnitudes, hrROIbegin, hrROIend, max);
+  isNewAnalysis = true;
+  signalToNoise = (magnitudes.at(0) < dcThreshold && signalToNoiseRatio > 0.0f) ? signalToNoiseRatio : 0.0f;
+  if (signalToNoiseRatio > signalToNoiseThreshold && magnitudes.at(0) < dcThreshold) {
     threshold *= max;
-    // Reuse VImag for interpolation x values passed to PeakSearch
-    for (int idx = 0; idx < dataLength; idx++) {
-      vImag[idx] = idx;
+    peakLocation = PeakSearch(magnitudes.data(), threshold, peakWidth, hrROIbegin, hrROIend);
+    // Part of the peak is hidden by the motion, its location can't be trusted
+    int firstBin = static_cast<int>(peakLocation - peakWidth / 2.0f);
+    int lastBin = static_cast<int>(peakLocation + peakWidth / 2.0f) + 1;
+    if (peakLocation > 0.0f && (maskedBins & ((1u << firstBin) | (1u << lastBin))) != 0) {
+      peakLocation = 0.0f;
     }
-    peakLocation = PeakSearch(vImag.data(),
-                              spectrum.data(),
-                              threshold,
-                              peakWidth,
-                              static_cast<float>(hrROIbegin),
-                              static_cast<float>(hrROIend),
-                              specLen);
     peakLocation *= freqResolution;
   }
   // Peak too wide? (broad spectrum noise or large, rapid HR change)
@@ -252,6 +391,174 @@ int Ppg::ProcessHeartRate(bool init) {
   return rtn;
 }
 
+#ifdef PPG_FIXED_POINT
+void Ppg::ComputeSpectrum(std::array<float, spectrumLength>& magnitudes) {
+  for (int idx = 0; idx < dataLength; idx++) {
+    vReal[idx] = static_cast<int32_t>(dataHRS[idx]) << fractionalBits;
+  }
+  Detrend(vReal);
+  Filter30to240(vReal);
+  vImag.fill(0);
+  // Apply Hanning Window
+  int hannIdx = 0;
+  for (int idx = 0; idx < dataLength; idx++) {
+    if (idx >= dataLength >> 1) {
+      hannIdx--;
+    }
+    vReal[idx] = static_cast<int32_t>((static_cast<int64_t>(vReal[idx]) * hanningQ15[hannIdx]) >> 15);
+    if (idx < dataLength >> 1) {
+      hannIdx++;
+    }
+  }
+  ComputeFFT(vReal, vImag);
+  constexpr float scale = 1.0f / static_cast<float>(1 << fractionalBits);
+  for (int idx = 0; idx < spectrumLength; idx++) {
+    int64_t re = vReal[idx];
+    int64_t im = vImag[idx];
+    magnitudes[idx] = static_cast<float>(SquareRoot(static_cast<uint64_t>(re * re + im * im))) * scale;
+  }
+}
+#else
+void Ppg::ComputeSpectrum(std::array<float, spectrumLength>& magnitudes) {
+  std::copy(dataHRS.begin(), dataHRS.end(), vReal.begin());
+  Detrend(vReal);
+  Filter30to240(vReal);
+  vImag.fill(0.0f);
+  // Apply Hanning Window
+  int hannIdx = 0;
+  for (int idx = 0; idx < dataLength; idx++) {
+    if (idx >= dataLength >> 1) {
+      hannIdx--;
+    }
+    vReal[idx] *= hanning[hannIdx];
+    if (idx < dataLength >> 1) {
+      hannIdx++;
+    }
+  }
+  // Compute in place power spectrum
+  ArduinoFFT<float> FFT = ArduinoFFT<float>(vReal.data(), vImag.data(), dataLength, sampleFreq);
+  FFT.compute(FFTDirection::Forward);
+  FFT.complexToMagnitude();
+  FFT.~ArduinoFFT();
+  std::copy(vReal.begin(), vReal.begin() + spectrumLength, magnitudes.begin());
+}
+#endif
+
+// Returns a mask of the bins of the HR region of interest where the acceleration spectrum has a significant peak
+uint32_t Ppg::MotionPeaks() {
+  static_assert(hrROIend < 32);
+  if (motionCount < dataLength) {
+    return 0;
+  }
+  int32_t mean = 0;
+  for (int16_t value : dataMotion) {
+    mean += value;
+  }
+  mean /= dataLength;
+  // Hanning windowed DFT, only over the bins of the region of interest
+  std::array<float, dataLength> windowed;
+  for (int idx = 0; idx < dataLength; idx++) {
+    int hannIdx = idx < dataLength >> 1 ? idx : dataLength - 1 - idx;
+    windowed[idx] = static_cast<float>(dataMotion[(motionIndex + idx) % dataLength] - mean) * hanning[hannIdx];
+  }
+  std::array<float, hrROIend + 1> motionSpectrum {};
+  float max = 0.0f;
+  for (int bin = hrROIbegin; bin <= hrROIend; bin++) {
+    float re = 0.0f;
+    float im = 0.0f;
+    for (int idx = 0; idx < dataLength; idx++) {
+      int phase = (bin * idx) % dataLength;
+      bool isFirstHalf = phase <= dataLength >> 1;
+      re += windowed[idx] * Cosine(isFirstHalf ? phase : dataLength - phase);
+      im -= windowed[idx] * (isFirstHalf ? Sine(phase) : -Sine(dataLength - phase));
+    }
+    motionSpectrum[bin] = std::sqrt(re * re + im * im);
+    max = std::max(max, motionSpectrum[bin]);
+  }
+  if (max < minMotionPeak) {
+    return 0;
+  }
+  uint32_t peaks = 0;
+  for (int bin = hrROIbegin; bin <= hrROIend; bin++) {
+    if (motionSpectrum[bin] >= peakDetectionThreshold * max) {
+      peaks |= 1u << bin;
+    }
+  }
+  return peaks;
+}
+
+// Streaming version of Detrend() and Filter30to240(), fed with the difference between consecutive samples
+float Ppg::FilterSample(float value) {
+  auto lowPass = filterState.begin();
+  auto highPass = filterState.begin() + 4;
+  for (int stage = 0; stage < 4; stage++) {
+    if (!filterSeeded) {
+      lowPass[stage] = value;
+    }
+    lowPass[stage] = 0.816f * value + (1 - 0.816f) * lowPass[stage];
+    value = lowPass[stage];
+  }
+  for (int stage = 0; stage < 4; stage++) {
+    if (!filterSeeded) {
+      highPass[stage] = value;
+    }
+    highPass[stage] = 0.268f * value + (1 - 0.268f) * highPass[stage];
+    value -= highPass[stage];
+  }
+  filterSeeded = true;
+  return value;
+}
+
+void Ppg::SlideSpectrum(uint32_t hrs) {
+  if (!hasLastSample) {
+    lastSample = hrs;
+    hasLastSample = true;
+    return;
+  }
+  float value = FilterSample(static_cast<float>(hrs) - static_cast<float>(lastSample));
+  lastSample = hrs;
+  float delta = value - slidingDampingN * filteredHRS[filteredIndex];
+  filteredHRS[filteredIndex] = value;
+  filteredIndex = (filteredIndex + 1) % dataLength;
+  // Add the new sample, remove the oldest one and rotate each bin by exp(2 * pi * j * k / dataLength)
+  for (int idx = 0; idx < slidingBins; idx++) {
+    float re = slidingDamping * slidingReal[idx] + delta;
+    float im = slidingDamping * slidingImag[idx];
+    slidingReal[idx] = re * Cosine(idx) - im * Sine(idx);
+    slidingImag[idx] = re * Sine(idx) + im * Cosine(idx);
+  }
+  if (filteredCount < dataLength) {
+    filteredCount++;
+  }
+  if (newSamples < overlapWindow) {
+    newSamples++;
+  }
+}
+
+void Ppg::SlidingMagnitudes(std::array<float, spectrumLength>& magnitudes) {
+  magnitudes.fill(0.0f);
+  for (int idx = 0; idx < slidingBins - 1; idx++) {
+    // Hanning window applied as a convolution in the frequency domain.
+    // The signal is real, so bin -1 is the conjugate of bin 1.
+    int previous = idx == 0 ? 1 : idx - 1;
+    float previousImag = idx == 0 ? -slidingImag[1] : slidingImag[previous];
+    float re = 0.5f * slidingReal[idx] - 0.25f * (slidingReal[previous] + slidingReal[idx + 1]);
+    float im = 0.5f * slidingImag[idx] - 0.25f * (previousImag + slidingImag[idx + 1]);
+    magnitudes[idx] = std::sqrt(re * re + im * im);
+  }
+}
+
+void Ppg::ResetSlidingSpectrum() {
+  filteredHRS.fill(0.0f);
+  slidingReal.fill(0.0f);
+  slidingImag.fill(0.0f);
+  filterSeeded = false;
+  hasLastSample = false;
+  filteredIndex = 0;
+  filteredCount = 0;
+  newSamples = 0;
+}
+
 void Ppg::SpectrumAverage(const float* data, float* spectrum, int length, bool reset) {
   if (reset) {
     spectralAvgCount = 0;
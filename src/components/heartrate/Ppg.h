@@ -3,20 +3,39 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#ifndef PPG_FIXED_POINT
 // Note: Change internal define 'sqrt_internal sqrt' to
 // 'sqrt_internal sqrtf' to save ~3KB of flash.
-#define sqrt_internal sqrtf
-#define FFT_SPEED_OVER_PRECISION
-#include "libs/arduinoFFT/src/arduinoFFT.h"
+  #define sqrt_internal sqrtf
+  #define FFT_SPEED_OVER_PRECISION
+  #include "libs/arduinoFFT/src/arduinoFFT.h"
+#endif
 
 namespace Pinetime {
   namespace Controllers {
     class Ppg {
     public:
       Ppg();
-      int8_t Preprocess(uint32_t hrs, uint32_t als);
+      // motion is the norm of the acceleration measured at the same time, in milli-g
+      int8_t Preprocess(uint32_t hrs, uint32_t als, int32_t motion);
       int HeartRate();
       void Reset(bool resetDaqBuffer);
+      // In incremental mode, the spectrum is updated on each new sample instead of being recomputed
+      // from the whole acquisition window on each analysis. Changing the mode resets all buffers.
+      void SetIncremental(bool enabled);
+
+      // Whether the last call to HeartRate() analysed the signal
+      bool IsNewAnalysis() const {
+        return isNewAnalysis;
+      }
+
+      // Signal to noise ratio of the spectrum at the last analysis, 0 if the signal was unusable
+      float SignalToNoiseRatio() const {
+        return signalToNoise;
+      }
+
+      // Metric for spectrum noise level.
+      static constexpr float signalToNoiseThreshold = 3.0f;
       static constexpr int deltaTms = 100;
       // Daq dataLength: Must be power of 2
       static constexpr uint16_t dataLength = 64;
@@ -37,8 +56,6 @@ namespace Pinetime {
       static constexpr float peakDetectionThreshold = 0.6f;
       // Maximum peak width (bins) at threshold for valid peak.
       static constexpr float maxPeakWidth = 2.5f;
-      // Metric for spectrum noise level.
-      static constexpr float signalToNoiseThreshold = 3.0f;
       // Heart rate Region Of Interest begin (bins)
       static constexpr uint16_t hrROIbegin = static_cast<uint16_t>((30.0f / 60.0f) / freqResolution + 0.5f);
       // Heart rate Region Of Interest end (bins)
@@ -51,13 +68,29 @@ namespace Pinetime {
       static constexpr float dcThreshold = 0.5f;
       // ALS detection factor
       static constexpr float alsFactor = 2.0f;
+      // Minimum motion spectrum peak (windowed, milli-g) for motion artifacts to be rejected.
+      // A 30 milli-g sinusoid gives a peak of ~500.
+      static constexpr float minMotionPeak = 500.0f;
 
       // Raw ADC data
       std::array<uint16_t, dataLength> dataHRS;
+      // Acceleration norm of the last samples, oldest first from motionIndex
+      std::array<int16_t, dataLength> dataMotion;
+      uint16_t motionIndex = 0;
+      uint16_t motionCount = 0;
+#ifdef PPG_FIXED_POINT
+      // Number of fractional bits of the samples processed in fixed point
+      static constexpr int fractionalBits = 8;
+      // Stores Real numbers from FFT
+      std::array<int32_t, dataLength> vReal;
+      // Stores Imaginary numbers from FFT
+      std::array<int32_t, dataLength> vImag;
+#else
       // Stores Real numbers from FFT
       std::array<float, dataLength> vReal;
       // Stores Imaginary numbers from FFT
       std::array<float, dataLength> vImag;
+#endif
       // Stores power spectrum calculated from FFT real and imag values
       std::array<float, (spectrumLength)> spectrum;
       // Stores each new HR value (Hz). Non zero values are averaged for HR output
@@ -71,9 +104,36 @@ namespace Pinetime {
       uint16_t dataIndex = 0;
       float peakLocation;
       bool resetSpectralAvg = true;
+      bool isNewAnalysis = false;
+      float signalToNoise = 0.0f;
+
+      // Highest bin updated by the sliding DFT. The Hanning window needs one more bin than the HR analysis.
+      static constexpr uint16_t slidingBins = hrROIend + 2;
+      static_assert(slidingBins <= spectrumLength);
+      bool incremental = false;
+      // Filtered samples of the current window, oldest first from filteredIndex
+      std::array<float, dataLength> filteredHRS;
+      // Sliding DFT of filteredHRS (real and imaginary parts), not windowed
+      std::array<float, slidingBins> slidingReal;
+      std::array<float, slidingBins> slidingImag;
+      // Moving averages of the streaming bandpass filter
+      std::array<float, 8> filterState;
+      bool filterSeeded = false;
+      bool hasLastSample = false;
+      uint32_t lastSample = 0;
+      uint16_t filteredIndex = 0;
+      uint16_t filteredCount = 0;
+      uint16_t newSamples = 0;
 
       int ProcessHeartRate(bool init);
+      // Fills magnitudes with the magnitude spectrum of the acquired samples
+      void ComputeSpectrum(std::array<float, spectrumLength>& magnitudes);
       float HeartRateAverage(float hr);
+      uint32_t MotionPeaks();
+      float FilterSample(float value);
+      void SlideSpectrum(uint32_t hrs);
+      void SlidingMagnitudes(std::array<float, spectrumLength>& magnitudes);
+      void ResetSlidingSpectrum();
       void SpectrumAverage(const float* data, float* spectrum, int length, bool reset);
     };
   }
@@ -0,0 +1,317 @@
+#include "components/history/HistoryController.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "components/datetime/DateTimeController.h"
+#include "components/fs/FS.h"
+
+using namespace Pinetime::Controllers;
+
+namespace {
+  constexpr const char* directory = "/history";
+
+  void SegmentPath(char* path, size_t size, uint32_t timestamp) {
+    snprintf(path, size, "%s/%08lx", directory, static_cast<unsigned long>(timestamp));
+  }
+
+  size_t WriteVarint(uint8_t* data, uint32_t value) {
+    size_t length = 0;
+    while (value >= 0x80) {
+      data[length++] = static_cast<uint8_t>(value) | 0x80;
+      value >>= 7;
+    }
+    data[length++] = static_cast<uint8_t>(value);
+    return length;
+  }
+
+  uint32_t ZigZag(int32_t value) {
+    return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+  }
+
+  int32_t UnZigZag(uint32_t value) {
+    return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+  }
+
+  class BufferReader {
+  public:
+    BufferReader(const uint8_t* data, size_t length) : data {data}, length {length} {
+    }
+
+    bool Next(uint8_t& value) {
+      if (position == length) {
+        return false;
+      }
+      value = data[position++];
+      return true;
+    }
+
+    size_t Position() const {
+      return position;
+    }
+
+  private:
+    const uint8_t* data;
+    size_t length;
+    size_t position = 0;
+  };
+
+  class FileReader {
+  public:
+    FileReader(FS& fs, lfs_file_t& file) : fs {fs}, file {file} {
+    }
+
+    bool Next(uint8_t& value) {
+      if (index == length) {
+        int result = fs.FileRead(&file, data.data(), data.size());
+        if (result <= 0) {
+          return false;
+        }
+        length = result;
+        index = 0;
+      }
+      value = data[index++];
+      position++;
+      return true;
+    }
+
+    size_t Position() const {
+      return position;
+    }
+
+  private:
+    FS& fs;
+    lfs_file_t& file;
+    std::array<uint8_t, 32> data;
+    size_t length = 0;
+    size_t index = 0;
+    size_t position = 0;
+  };
+
+  template <typename Reader>
+  bool ReadVarint(Reader& reader, uint32_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+      uint8_t byte;
+      if (!reader.Next(byte)) {
+        return false;
+      }
+      value |= static_cast<uint32_t>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  template <typename Reader>
+  bool ReadLittleEndian(Reader& reader, size_t size, uint32_t& value) {
+    value = 0;
+    for (size_t idx = 0; idx < size; idx++) {
+      uint8_t byte;
+      if (!reader.Next(byte)) {
+        return false;
+      }
+      value |= static_cast<uint32_t>(byte) << (8 * idx);
+    }
+    return true;
+  }
+
+  struct QueryState {
+    HistoryController::Series series;
+    uint32_t from;
+    uint32_t to;
+    std::span<HistoryController::Sample> samples;
+    size_t count = 0;
+  };
+
+  // Adds the matching samples of a chunk to the query, returns false once the query is complete
+  template <typename Reader>
+  bool DecodeChunk(Reader& reader, size_t length, uint32_t timestamp, QueryState& query) {
+    size_t end = reader.Position() + length;
+    uint8_t heartRate = 0;
+    while (reader.Position() < end) {
+      uint32_t key;
+      uint32_t value;
+      if (!ReadVarint(reader, key) || !ReadVarint(reader, value)) {
+        return false;
+      }
+      timestamp += key >> 2;
+      auto series = static_cast<HistoryController::Series>(key & 0x03);
+      if (series == HistoryController::Series::HeartRate) {
+        heartRate += UnZigZag(value);
+        value = heartRate;
+      }
+      if (timestamp >= query.to) {
+        return false;
+      }
+      if (series == query.series && timestamp >= query.from) {
+        query.samples[query.count++] = {timestamp, value};
+        if (query.count == query.samples.size()) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+}
+
+HistoryController::HistoryController(DateTime& dateTimeController, FS& fs) : dateTimeController {dateTimeController}, fs {fs} {
+}
+
+void HistoryController::Init() {
+  mutex = xSemaphoreCreateMutex();
+
+  fs.DirCreate(directory);
+  lfs_dir_t dir;
+  if (fs.DirOpen(directory, &dir) != LFS_ERR_OK) {
+    return;
+  }
+  lfs_info info;
+  uint32_t newest = 0;
+  while (fs.DirRead(&dir, &info) > 0 && nbSegments < maxSegments) {
+    char* end;
+    uint32_t timestamp = strtoul(info.name, &end, 16);
+    if (info.type != LFS_TYPE_REG || *end != '\0') {
+      continue;
+    }
+    if (nbSegments == 0 || timestamp > newest) {
+      newest = timestamp;
+      lastSegmentSize = info.size;
+    }
+    segments[nbSegments++] = timestamp;
+  }
+  fs.DirClose(&dir);
+  std::sort(segments.begin(), segments.begin() + nbSegments);
+}
+
+uint32_t HistoryController::Now() const {
+  return std::chrono::duration_cast<std::chrono::seconds>(dateTimeController.UTCDateTime().time_since_epoch()).count();
+}
+
+void HistoryController::AddHeartRate(uint8_t heartRate) {
+  uint32_t now = Now();
+  if (lastHeartRateTimestamp != 0 && now - lastHeartRateTimestamp < minHeartRateInterval) {
+    return;
+  }
+  lastHeartRateTimestamp = now;
+  Append(Series::HeartRate, now, heartRate);
+}
+
+void HistoryController::AddHourlySteps(uint32_t stepCount) {
+  // The step count is reset every day
+  uint32_t steps = stepCount >= lastStepCount ? stepCount - lastStepCount : stepCount;
+  lastStepCount = stepCount;
+  Append(Series::Steps, Now(), steps);
+  isFlushNeeded = true;
+}
+
+void HistoryController::Append(Series series, uint32_t timestamp, uint32_t value) {
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  if (bufferLength == 0) {
+    chunkStart = timestamp;
+    lastTimestamp = timestamp;
+    lastHeartRate = 0;
+  }
+  if (timestamp >= lastTimestamp && bufferLength + maxRecordSize <= bufferSize) {
+    uint8_t* data = buffer.data() + bufferLength;
+    size_t length = WriteVarint(data, ((timestamp - lastTimestamp) << 2) | static_cast<uint32_t>(series));
+    if (series == Series::HeartRate) {
+      length += WriteVarint(data + length, ZigZag(static_cast<int32_t>(value) - lastHeartRate));
+      lastHeartRate = value;
+    } else {
+      length += WriteVarint(data + length, value);
+    }
+    bufferLength += length;
+    lastTimestamp = timestamp;
+  }
+  // If the time went backwards, the record is dropped and the chunk is closed so that the next one starts from the new time
+  if (timestamp < lastTimestamp || bufferLength > bufferSize * 3 / 4) {
+    isFlushNeeded = true;
+  }
+  xSemaphoreGive(mutex);
+}
+
+void HistoryController::Flush() {
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  isFlushNeeded = false;
+  if (bufferLength > 0) {
+    size_t chunkSize = chunkHeaderSize + bufferLength;
+    if (nbSegments == 0 || lastSegmentSize + chunkSize > FS::getBlockSize()) {
+      StartSegment(chunkStart);
+    }
+    char path[32];
+    SegmentPath(path, sizeof(path), segments[nbSegments - 1]);
+    lfs_file_t file;
+    if (fs.FileOpen(&file, path, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_APPEND) == LFS_ERR_OK) {
+      uint8_t header[chunkHeaderSize] = {static_cast<uint8_t>(chunkStart),
+                                         static_cast<uint8_t>(chunkStart >> 8),
+                                         static_cast<uint8_t>(chunkStart >> 16),
+                                         static_cast<uint8_t>(chunkStart >> 24),
+                                         static_cast<uint8_t>(bufferLength),
+                                         static_cast<uint8_t>(bufferLength >> 8)};
+      fs.FileWrite(&file, header, sizeof(header));
+      fs.FileWrite(&file, buffer.data(), bufferLength);
+      fs.FileClose(&file);
+      lastSegmentSize += chunkSize;
+    }
+    bufferLength = 0;
+  }
+  xSemaphoreGive(mutex);
+}
+
+void HistoryController::StartSegment(uint32_t timestamp) {
+  // Keep the segments ordered by name even if the time went backwards
+  if (nbSegments > 0) {
+    timestamp = std::max(timestamp, segments[nbSegments - 1] + 1);
+  }
+  if (nbSegments == maxSegments) {
+    char path[32];
+    SegmentPath(path, sizeof(path), segments[0]);
+    fs.FileDelete(path);
+    std::copy(segments.begin() + 1, segments.end(), segments.begin());
+    nbSegments--;
+  }
+  segments[nbSegments++] = timestamp;
+  lastSegmentSize = 0;
+}
+
+size_t HistoryController::Query(Series series, uint32_t from, uint32_t to, std::span<Sample> samples) {
+  if (samples.empty()) {
+    return 0;
+  }
+  QueryState query {series, from, to, samples};
+  bool isComplete = false;
+
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  for (size_t idx = 0; idx < nbSegments && !isComplete; idx++) {
+    if (idx + 1 < nbSegments && segments[idx + 1] <= from) {
+      continue;
+    }
+    if (segments[idx] >= to) {
+      break;
+    }
+    char path[32];
+    SegmentPath(path, sizeof(path), segments[idx]);
+    lfs_file_t file;
+    if (fs.FileOpen(&file, path, LFS_O_RDONLY) != LFS_ERR_OK) {
+      continue;
+    }
+    FileReader reader {fs, file};
+    uint32_t start;
+    uint32_t length;
+    while (!isComplete && ReadLittleEndian(reader, 4, start) && ReadLittleEndian(reader, 2, length)) {
+      isComplete = !DecodeChunk(reader, length, start, query);
+    }
+    fs.FileClose(&file);
+  }
+  if (!isComplete && bufferLength > 0) {
+    BufferReader reader {buffer.data(), bufferLength};
+    DecodeChunk(reader, bufferLength, chunkStart, query);
+  }
+  xSemaphoreGive(mutex);
+
+  return query.count;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <FreeRTOS.h>
+#include <semphr.h>
+
+namespace Pinetime {
+  namespace Controllers {
+    class DateTime;
+    class FS;
+
+    // Persistent time series of the heart rate and of the steps per hour.
+    //
+    // The samples are buffered in RAM and appended to the file system in chunks, at least once per hour. A chunk starts
+    // with its timestamp (uint32, seconds since the epoch in UTC) and the size of its records (uint16). Each record is
+    // a varint of (seconds since the previous record << 2 | series), followed by a zigzag varint of the difference with
+    // the previous heart rate of the chunk, or by a varint of the number of steps.
+    // The chunks are stored in segment files of at most one flash block, named after the timestamp of their first chunk.
+    // The oldest segment is deleted when maxSegments is reached.
+    class HistoryController {
+    public:
+      enum class Series : uint8_t { HeartRate, Steps };
+
+      struct Sample {
+        uint32_t timestamp;
+        uint32_t value;
+      };
+
+      HistoryController(DateTime& dateTimeController, FS& fs);
+
+      void Init();
+
+      // Records the heart rate, at most once every minHeartRateInterval seconds
+      void AddHeartRate(uint8_t heartRate);
+      // Records the steps done since the previous call, stepCount being the number of steps of the day
+      void AddHourlySteps(uint32_t stepCount);
+
+      // Whether Flush() should be called, the file system must be awake to call it
+      bool IsFlushNeeded() const {
+        return isFlushNeeded;
+      }
+
+      void Flush();
+
+      // Fills samples with the samples of series recorded in [from, to), oldest first, and returns their number.
+      // When samples is full, the query can be continued from the timestamp of the last sample + 1.
+      size_t Query(Series series, uint32_t from, uint32_t to, std::span<Sample> samples);
+
+    private:
+      static constexpr size_t bufferSize = 256;
+      static constexpr size_t chunkHeaderSize = 6;
+      static constexpr size_t maxRecordSize = 10;
+      static constexpr size_t maxSegments = 32;
+      static constexpr uint32_t minHeartRateInterval = 60;
+
+      DateTime& dateTimeController;
+      FS& fs;
+      SemaphoreHandle_t mutex = nullptr;
+
+      // Records of the chunk not written yet
+      std::array<uint8_t, bufferSize> buffer;
+      size_t bufferLength = 0;
+      uint32_t chunkStart = 0;
+      uint32_t lastTimestamp = 0;
+      uint8_t lastHeartRate = 0;
+      bool isFlushNeeded = false;
+
+      uint32_t lastHeartRateTimestamp = 0;
+      uint32_t lastStepCount = 0;
+
+      // Start timestamps of the segments, oldest first
+      std::array<uint32_t, maxSegments> segments;
+      size_t nbSegments = 0;
+      size_t lastSegmentSize = 0;
+
+      uint32_t Now() const;
+      void Append(Series series, uint32_t timestamp, uint32_t value);
+      void StartSegment(uint32_t timestamp);
+    };
+  }
+}
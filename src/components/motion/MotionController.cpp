@@ -1,5 +1,7 @@
 #include "components/motion/MotionController.h"
 
+#include <algorithm>
+
 #include <task.h>
 
 #include "utility/Math.h"
@@ -35,44 +37,77 @@ namespace {
   }
 }
 
-void MotionController::Update(int16_t x, int16_t y, int16_t z, uint32_t nbSteps) {
-  if (this->nbSteps != nbSteps && service != nullptr) {
-    service->OnNewStepCountValue(nbSteps);
+void MotionController::Update(std::span<const Pinetime::Drivers::Bma421::Values> values, TickType_t timestamp, TickType_t samplePeriod) {
+  if (values.empty()) {
+    return;
   }
 
-  if (service != nullptr && (xHistory[0] != x || yHistory[0] != y || zHistory[0] != z)) {
-    service->OnNewMotionValues(x, y, z);
+  const auto& newest = values.back();
+  if (service != nullptr && (history[0].x != newest.x || history[0].y != newest.y || history[0].z != newest.z)) {
+    service->OnNewMotionValues(newest.x, newest.y, newest.z);
   }
 
-  lastTime = time;
-  time = xTaskGetTickCount();
+  peakShakeSpeed = 0;
+  raiseWristDetected = false;
+  lowerWristDetected = false;
+
+  TickType_t sampleTime = timestamp - (values.size() - 1) * samplePeriod;
+  for (const auto& value : values) {
+    lastTime = time;
+    time = sampleTime;
+    sampleTime += samplePeriod;
+
+    history++;
+    history[0] = {value.x, value.y, value.z};
+
+    int32_t magnitude = Pedometer::Magnitude(value.x, value.y, value.z);
+    taskENTER_CRITICAL();
+    magnitudes++;
+    magnitudes[0] = {time, magnitude};
+    nbMagnitudes = std::min<uint8_t>(nbMagnitudes + 1, magnitudeHistSize);
+    taskEXIT_CRITICAL();
 
-  xHistory++;
-  xHistory[0] = x;
-  yHistory++;
-  yHistory[0] = y;
-  zHistory++;
-  zHistory[0] = z;
+    // Bound the interval so that the conversion cannot overflow after a long pause
+    TickType_t elapsed = std::min<TickType_t>(time - lastTime, configTICK_RATE_HZ * 10);
+    pedometer.Process(value.x, value.y, value.z, elapsed * 1000 / configTICK_RATE_HZ);
 
-  stats = GetAccelStats();
+    stats = GetAccelStats();
 
-  int32_t deltaSteps = nbSteps - this->nbSteps;
+    UpdateShakeSpeed();
+    peakShakeSpeed = std::max(peakShakeSpeed, accumulatedSpeed);
+    raiseWristDetected = raiseWristDetected || IsRaiseWristGesture();
+    lowerWristDetected = lowerWristDetected || IsLowerWristGesture();
+  }
+
+  uint32_t steps = IsStepCountingInSoftware() ? pedometer.NbSteps() : newest.steps;
+  if (this->nbSteps != steps && service != nullptr) {
+    service->OnNewStepCountValue(steps);
+  }
+
+  int32_t deltaSteps = steps - this->nbSteps;
   if (deltaSteps > 0) {
     currentTripSteps += deltaSteps;
   }
-  this->nbSteps = nbSteps;
+  if (this->nbSteps != steps) {
+    this->nbSteps = steps;
+    if (changeListener != nullptr) {
+      changeListener->OnChange(ChangeEvents::Steps);
+    }
+  }
 }
 
 MotionController::AccelStats MotionController::GetAccelStats() const {
   AccelStats stats;
 
   for (uint8_t i = 0; i < AccelStats::numHistory; i++) {
-    stats.xMean += xHistory[histSize - i];
-    stats.yMean += yHistory[histSize - i];
-    stats.zMean += zHistory[histSize - i];
-    stats.prevXMean += xHistory[1 + i];
-    stats.prevYMean += yHistory[1 + i];
-    stats.prevZMean += zHistory[1 + i];
+    const Sample& recent = history[histSize - i];
+    const Sample& old = history[1 + i];
+    stats.xMean += recent.x;
+    stats.yMean += recent.y;
+    stats.zMean += recent.z;
+    stats.prevXMean += old.x;
+    stats.prevYMean += old.y;
+    stats.prevZMean += old.z;
   }
   stats.xMean /= AccelStats::numHistory;
   stats.yMean /= AccelStats::numHistory;
@@ -82,9 +117,10 @@ MotionController::AccelStats MotionController::GetAccelStats() const {
   stats.prevZMean /= AccelStats::numHistory;
 
   for (uint8_t i = 0; i < AccelStats::numHistory; i++) {
-    stats.xVariance += (xHistory[histSize - i] - stats.xMean) * (xHistory[histSize - i] - stats.xMean);
-    stats.yVariance += (yHistory[histSize - i] - stats.yMean) * (yHistory[histSize - i] - stats.yMean);
-    stats.zVariance += (zHistory[histSize - i] - stats.zMean) * (zHistory[histSize - i] - stats.zMean);
+    const Sample& recent = history[histSize - i];
+    stats.xVariance += (recent.x - stats.xMean) * (recent.x - stats.xMean);
+    stats.yVariance += (recent.y - stats.yMean) * (recent.y - stats.yMean);
+    stats.zVariance += (recent.z - stats.zMean) * (recent.z - stats.zMean);
   }
   stats.xVariance /= AccelStats::numHistory;
   stats.yVariance /= AccelStats::numHistory;
@@ -93,7 +129,7 @@ MotionController::AccelStats MotionController::GetAccelStats() const {
   return stats;
 }
 
-bool MotionController::ShouldRaiseWake() const {
+bool MotionController::IsRaiseWristGesture() const {
   constexpr uint32_t varianceThresh = 56 * 56;
   constexpr int16_t xThresh = 384;
   constexpr int16_t yThresh = -64;
@@ -111,18 +147,49 @@ bool MotionController::ShouldRaiseWake() const {
   return DegreesRolled(stats.yMean, stats.zMean, stats.prevYMean, stats.prevZMean) < rollDegreesThresh;
 }
 
-bool MotionController::ShouldShakeWake(uint16_t thresh) {
-  /* Currently Polling at 10hz, If this ever goes faster scalar and EMA might need adjusting */
-  int32_t speed = std::abs(zHistory[0] - zHistory[histSize - 1] + (yHistory[0] - yHistory[histSize - 1]) / 2 +
-                           (xHistory[0] - xHistory[histSize - 1]) / 4) *
-                  100 / (time - lastTime);
+bool MotionController::ShouldRaiseWake() const {
+  return raiseWristDetected;
+}
+
+void MotionController::UpdateShakeSpeed() {
+  /* Samples arrive at 12.5hz from the accelerometer FIFO, If this ever goes faster scalar and EMA might need adjusting */
+  const Sample& newest = history[0];
+  const Sample& previous = history[histSize - 1];
+  // Batches are timestamped when they are read, make sure jitter never results in a null interval
+  int32_t interval = std::max<int32_t>(static_cast<int32_t>(time - lastTime), 1);
+  int32_t speed = std::abs(newest.z - previous.z + (newest.y - previous.y) / 2 + (newest.x - previous.x) / 4) * 100 / interval;
   // (.2 * speed) + ((1 - .2) * accumulatedSpeed);
   accumulatedSpeed = speed / 5 + accumulatedSpeed * 4 / 5;
+}
 
-  return accumulatedSpeed > thresh;
+int32_t MotionController::MagnitudeAt(TickType_t time) const {
+  taskENTER_CRITICAL();
+  int32_t magnitude = nbMagnitudes > 0 ? magnitudes[0].magnitude : 0;
+  // magnitudes[0] is the newest sample, magnitudes[magnitudeHistSize - n] the one measured n samples before
+  for (uint8_t i = 0; i + 1 < nbMagnitudes; i++) {
+    const TimedMagnitude& newer = magnitudes[(magnitudeHistSize - i) % magnitudeHistSize];
+    const TimedMagnitude& older = magnitudes[magnitudeHistSize - i - 1];
+    if (static_cast<int32_t>(time - newer.time) >= 0) {
+      break;
+    }
+    if (static_cast<int32_t>(time - older.time) >= 0) {
+      auto elapsed = static_cast<int32_t>(time - older.time);
+      auto period = static_cast<int32_t>(newer.time - older.time);
+      magnitude = older.magnitude + (newer.magnitude - older.magnitude) * elapsed / period;
+      break;
+    }
+    // Older than all the samples
+    magnitude = older.magnitude;
+  }
+  taskEXIT_CRITICAL();
+  return magnitude;
 }
 
-bool MotionController::ShouldLowerSleep() const {
+bool MotionController::ShouldShakeWake(uint16_t thresh) const {
+  return peakShakeSpeed > thresh;
+}
+
+bool MotionController::IsLowerWristGesture() const {
   if ((stats.xMean > 887 && DegreesRolled(stats.xMean, stats.zMean, stats.prevXMean, stats.prevZMean) > 30) ||
       (stats.xMean < -887 && DegreesRolled(stats.xMean, stats.zMean, stats.prevXMean, stats.prevZMean) < -30)) {
     return true;
@@ -132,8 +199,8 @@ bool MotionController::ShouldLowerSleep() const {
     return false;
   }
 
-  for (uint8_t i = AccelStats::numHistory + 1; i < yHistory.Size(); i++) {
-    if (yHistory[i] < 265) {
+  for (uint8_t i = AccelStats::numHistory + 1; i < history.Size(); i++) {
+    if (history[i].y < 265) {
       return false;
     }
   }
@@ -141,6 +208,10 @@ bool MotionController::ShouldLowerSleep() const {
   return true;
 }
 
+bool MotionController::ShouldLowerSleep() const {
+  return lowerWristDetected;
+}
+
 void MotionController::Init(Pinetime::Drivers::Bma421::DeviceTypes types) {
   switch (types) {
     case Drivers::Bma421::DeviceTypes::BMA421:
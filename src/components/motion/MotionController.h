@@ -1,12 +1,15 @@
 #pragma once
 
 #include <cstdint>
+#include <span>
 
 #include <FreeRTOS.h>
 
 #include "drivers/Bma421.h"
 #include "components/ble/MotionService.h"
+#include "components/motion/Pedometer.h"
 #include "utility/CircularBuffer.h"
+#include "components/ChangeListener.h"
 
 namespace Pinetime {
   namespace Controllers {
@@ -18,24 +21,50 @@ namespace Pinetime {
         BMA425,
       };
 
-      void Update(int16_t x, int16_t y, int16_t z, uint32_t nbSteps);
+      // Processes a batch of samples ordered from the oldest to the newest, measured samplePeriod ticks apart.
+      // timestamp is the tick count at which the newest sample was measured.
+      void Update(std::span<const Pinetime::Drivers::Bma421::Values> values, TickType_t timestamp, TickType_t samplePeriod);
 
       int16_t X() const {
-        return xHistory[0];
+        return history[0].x;
       }
 
       int16_t Y() const {
-        return yHistory[0];
+        return history[0].y;
       }
 
       int16_t Z() const {
-        return zHistory[0];
+        return history[0].z;
       }
 
+      // A sample is available to MagnitudeAt() at most this long after it was measured: the FIFO of the sensor is
+      // drained once fifoWatermark samples are buffered
+      static constexpr TickType_t sampleLatency =
+        pdMS_TO_TICKS(Pinetime::Drivers::Bma421::fifoWatermark * Pinetime::Drivers::Bma421::fifoSamplePeriodMs + 200);
+
+      // Norm of the acceleration at the given tick count, in milli-g, interpolated between the samples measured around it.
+      // Can be called from any task.
+      int32_t MagnitudeAt(TickType_t time) const;
+
       uint32_t NbSteps() const {
         return nbSteps;
       }
 
+      // Resets the steps counted in software, the caller must also reset the step counter of the sensor
+      void ResetStepCount() {
+        pedometer.ResetStepCount();
+      }
+
+      // The step counter of the BMA425 feature engine is not reliable, the steps are counted from the samples instead.
+      // The samples must then be processed continuously, even while sleeping.
+      bool IsStepCountingInSoftware() const {
+        return deviceType != DeviceTypes::BMA421;
+      }
+
+      Pedometer::Activity CurrentActivity() const {
+        return pedometer.CurrentActivity();
+      }
+
       void ResetTrip() {
         currentTripSteps = 0;
       }
@@ -44,7 +73,9 @@ namespace Pinetime {
         return currentTripSteps;
       }
 
-      bool ShouldShakeWake(uint16_t thresh);
+      // The gestures are evaluated on each sample, these return whether one of the samples of the last batch
+      // passed to Update() completed them
+      bool ShouldShakeWake(uint16_t thresh) const;
       bool ShouldRaiseWake() const;
       bool ShouldLowerSleep() const;
 
@@ -66,6 +97,10 @@ namespace Pinetime {
         return service;
       }
 
+      void SetChangeListener(ChangeListener* listener) {
+        changeListener = listener;
+      }
+
     private:
       uint32_t nbSteps = 0;
       uint32_t currentTripSteps = 0;
@@ -88,18 +123,42 @@ namespace Pinetime {
         uint32_t zVariance = 0;
       };
 
+      struct Sample {
+        int16_t x;
+        int16_t y;
+        int16_t z;
+      };
+
       AccelStats GetAccelStats() const;
+      void UpdateShakeSpeed();
+      bool IsRaiseWristGesture() const;
+      bool IsLowerWristGesture() const;
 
       AccelStats stats = {};
 
       static constexpr uint8_t histSize = 8;
-      Utility::CircularBuffer<int16_t, histSize> xHistory = {};
-      Utility::CircularBuffer<int16_t, histSize> yHistory = {};
-      Utility::CircularBuffer<int16_t, histSize> zHistory = {};
+      Utility::CircularBuffer<Sample, histSize> history = {};
+
+      struct TimedMagnitude {
+        TickType_t time;
+        int32_t magnitude;
+      };
+
+      // Covers sampleLatency and one FIFO batch, written by Update() and read by MagnitudeAt() in critical sections
+      static constexpr uint8_t magnitudeHistSize = 32;
+      Utility::CircularBuffer<TimedMagnitude, magnitudeHistSize> magnitudes = {};
+      uint8_t nbMagnitudes = 0;
+
       int32_t accumulatedSpeed = 0;
+      Pedometer pedometer;
+
+      int32_t peakShakeSpeed = 0;
+      bool raiseWristDetected = false;
+      bool lowerWristDetected = false;
 
       DeviceTypes deviceType = DeviceTypes::Unknown;
       Pinetime::Controllers::MotionService* service = nullptr;
+      ChangeListener* changeListener = nullptr;
     };
   }
 }
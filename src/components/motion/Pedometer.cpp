@@ -0,0 +1,85 @@
+#include "components/motion/Pedometer.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+using namespace Pinetime::Controllers;
+
+int32_t Pedometer::Magnitude(int16_t x, int16_t y, int16_t z) {
+  int32_t a = std::abs(x);
+  int32_t b = std::abs(y);
+  int32_t c = std::abs(z);
+  if (a < b) {
+    std::swap(a, b);
+  }
+  if (b < c) {
+    std::swap(b, c);
+  }
+  if (a < b) {
+    std::swap(a, b);
+  }
+  return a + (11 * b + 8 * c) / 32;
+}
+
+void Pedometer::Process(int16_t x, int16_t y, int16_t z, uint32_t elapsedMs) {
+  int32_t magnitude = Magnitude(x, y, z);
+  if (!isInitialized) {
+    gravity = magnitude * 16;
+    isInitialized = true;
+  }
+
+  // Remove gravity with a slow moving average, then smooth the remaining acceleration over two samples
+  gravity += magnitude - gravity / 16;
+  int32_t acceleration = magnitude - gravity / 16;
+  int32_t filtered = (acceleration + previousAcceleration) / 2;
+  previousAcceleration = acceleration;
+
+  envelope += std::abs(filtered) - envelope / 8;
+  int32_t threshold = std::max(minStepThreshold, envelope / 16);
+
+  timeSinceLastStepMs = std::min(timeSinceLastStepMs + elapsedMs, maxStepIntervalMs + 1);
+
+  // A step is a trough followed by a peak, both beyond the threshold
+  if (filtered < -threshold) {
+    isArmed = true;
+  } else if (isArmed && filtered > threshold) {
+    isArmed = false;
+    if (timeSinceLastStepMs >= minStepIntervalMs) {
+      OnStep();
+    }
+  }
+}
+
+void Pedometer::OnStep() {
+  if (timeSinceLastStepMs > maxStepIntervalMs) {
+    consecutiveSteps = 0;
+    stepInterval = maxStepIntervalMs * 4;
+  } else {
+    stepInterval += timeSinceLastStepMs - stepInterval / 4;
+  }
+  timeSinceLastStepMs = 0;
+
+  if (consecutiveSteps < minConsecutiveSteps) {
+    // The steps of a walk are only counted once enough of them confirm it
+    consecutiveSteps++;
+    if (consecutiveSteps == minConsecutiveSteps) {
+      nbSteps += minConsecutiveSteps;
+    }
+    return;
+  }
+  nbSteps++;
+}
+
+void Pedometer::ResetStepCount() {
+  nbSteps = 0;
+}
+
+Pedometer::Activity Pedometer::CurrentActivity() const {
+  if (consecutiveSteps < minConsecutiveSteps || timeSinceLastStepMs > maxStepIntervalMs) {
+    return Activity::Idle;
+  }
+  if (stepInterval / 4 < runningStepIntervalMs || envelope / 8 > runningAmplitude) {
+    return Activity::Running;
+  }
+  return Activity::Walking;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Pinetime {
+  namespace Controllers {
+    // Step counter and activity classifier working on the raw accelerometer samples, for the sensors whose
+    // feature engine cannot be relied upon. All the computations are done in fixed point with a constant number
+    // of operations per sample.
+    class Pedometer {
+    public:
+      enum class Activity : uint8_t { Idle, Walking, Running };
+
+      // x, y and z are in binary milli-g (1g = 1024), elapsedMs is the time since the previous sample
+      void Process(int16_t x, int16_t y, int16_t z, uint32_t elapsedMs);
+      // Approximates the norm of the acceleration without a square root: max + 11/32 mid + 1/4 min, within 8%
+      static int32_t Magnitude(int16_t x, int16_t y, int16_t z);
+      void ResetStepCount();
+
+      uint32_t NbSteps() const {
+        return nbSteps;
+      }
+
+      Activity CurrentActivity() const;
+
+    private:
+      // Steps closer than this are bounces of the same step
+      static constexpr uint32_t minStepIntervalMs = 250;
+      // Steps further apart than this end the current walk
+      static constexpr uint32_t maxStepIntervalMs = 2000;
+      // Number of regular steps needed before a walk is counted, to ignore isolated movements of the arm
+      static constexpr uint8_t minConsecutiveSteps = 4;
+      // Minimum acceleration swing around gravity (milli-g) for a step
+      static constexpr int32_t minStepThreshold = 64;
+      // Cadence (160 steps/min) and amplitude (milli-g) above which the activity is considered running
+      static constexpr uint32_t runningStepIntervalMs = 375;
+      static constexpr int32_t runningAmplitude = 600;
+
+      uint32_t nbSteps = 0;
+      uint8_t consecutiveSteps = 0;
+
+      bool isInitialized = false;
+      // Estimate of gravity, in milli-g scaled by 16
+      int32_t gravity = 0;
+      int32_t previousAcceleration = 0;
+      // Mean absolute acceleration once gravity is removed, in milli-g scaled by 8
+      int32_t envelope = 0;
+      bool isArmed = false;
+
+      uint32_t timeSinceLastStepMs = maxStepIntervalMs;
+      // Mean interval between steps, in milliseconds scaled by 4
+      uint32_t stepInterval = maxStepIntervalMs * 4;
+
+      void OnStep();
+    };
+  }
+}
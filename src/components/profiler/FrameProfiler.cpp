@@ -0,0 +1,80 @@
+#include "components/profiler/FrameProfiler.h"
+#include <nrf.h>
+
+using namespace Pinetime::Controllers;
+
+void FrameProfiler::Init() {
+  // The cycle counter is only enabled by default when a debugger is attached
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+uint32_t FrameProfiler::CycleCount() {
+  return DWT->CYCCNT;
+}
+
+uint32_t FrameProfiler::CyclesToUs(uint32_t cycles) {
+  return cycles / (SystemCoreClock / 1000000);
+}
+
+void FrameProfiler::StartFrame() {
+  flushCycles = 0;
+  spiWaitCycles = 0;
+  bytesSent = 0;
+  frameStart = CycleCount();
+}
+
+void FrameProfiler::EndFrame() {
+  if (bytesSent == 0) {
+    return;
+  }
+
+  const uint32_t frameCycles = CycleCount() - frameStart;
+  frames[nextFrame] = {.renderTime = CyclesToUs(frameCycles - flushCycles),
+                       .flushTime = CyclesToUs(flushCycles),
+                       .spiWaitTime = CyclesToUs(spiWaitCycles),
+                       .bytesSent = bytesSent};
+  nextFrame = (nextFrame + 1) % maxFrames;
+  totalFrames++;
+}
+
+void FrameProfiler::StartFlush() {
+  flushStart = CycleCount();
+}
+
+void FrameProfiler::EndSpiWait() {
+  spiWaitCycles += CycleCount() - flushStart;
+}
+
+void FrameProfiler::EndFlush(uint32_t bytes) {
+  flushCycles += CycleCount() - flushStart;
+  bytesSent += bytes;
+}
+
+size_t FrameProfiler::NbFrames() const {
+  return totalFrames < maxFrames ? totalFrames : maxFrames;
+}
+
+const FrameProfiler::Frame& FrameProfiler::GetFrame(size_t nbFramesAgo) const {
+  return frames[(nextFrame + maxFrames - 1 - nbFramesAgo) % maxFrames];
+}
+
+FrameProfiler::Frame FrameProfiler::Average() const {
+  const auto nbFrames = static_cast<uint32_t>(NbFrames());
+  if (nbFrames == 0) {
+    return {};
+  }
+
+  Frame sum {};
+  for (uint32_t i = 0; i < nbFrames; i++) {
+    sum.renderTime += frames[i].renderTime;
+    sum.flushTime += frames[i].flushTime;
+    sum.spiWaitTime += frames[i].spiWaitTime;
+    sum.bytesSent += frames[i].bytesSent;
+  }
+  return {.renderTime = sum.renderTime / nbFrames,
+          .flushTime = sum.flushTime / nbFrames,
+          .spiWaitTime = sum.spiWaitTime / nbFrames,
+          .bytesSent = sum.bytesSent / nbFrames};
+}
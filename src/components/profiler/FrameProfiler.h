@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Pinetime {
+  namespace Controllers {
+    // Measures how long the display task spends rendering and flushing each frame, using the DWT cycle counter.
+    // The last maxFrames frames are kept in a ring buffer.
+    class FrameProfiler {
+    public:
+      // Times are in microseconds
+      struct Frame {
+        uint32_t renderTime;  // Time spent in the LVGL tasks, flushes excluded
+        uint32_t flushTime;   // Time spent in LittleVgl::FlushDisplay(), SPI wait included
+        uint32_t spiWaitTime; // Time spent waiting for the previous SPI transfer to complete
+        uint32_t bytesSent;
+      };
+      static constexpr size_t maxFrames = 32;
+
+      void Init();
+
+      // Called by the display task around the LVGL tasks and each flush.
+      // Frames during which nothing was flushed are not recorded.
+      void StartFrame();
+      void EndFrame();
+      void StartFlush();
+      void EndSpiWait();
+      void EndFlush(uint32_t bytes);
+
+      // Number of frames in the ring buffer
+      size_t NbFrames() const;
+      // Frame recorded nbFramesAgo frames ago (0 is the last frame)
+      const Frame& GetFrame(size_t nbFramesAgo) const;
+      Frame Average() const;
+
+      uint32_t TotalFrames() const {
+        return totalFrames;
+      }
+
+    private:
+      static uint32_t CycleCount();
+      static uint32_t CyclesToUs(uint32_t cycles);
+
+      std::array<Frame, maxFrames> frames {};
+      size_t nextFrame = 0;
+      uint32_t totalFrames = 0;
+
+      // Measures of the current frame, in cycles
+      uint32_t frameStart = 0;
+      uint32_t flushStart = 0;
+      uint32_t flushCycles = 0;
+      uint32_t spiWaitCycles = 0;
+      uint32_t bytesSent = 0;
+    };
+  }
+}
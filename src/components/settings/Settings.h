@@ -14,6 +14,8 @@ namespace Pinetime {
       enum class Notification : uint8_t { On, Off, Sleep };
       enum class ChimesOption : uint8_t { None, Hours, HalfHours };
       enum class WakeUpMode : uint8_t { SingleTap = 0, DoubleTap = 1, RaiseWrist = 2, Shake = 3, LowerWrist = 4 };
+      // Where wrist raise and shake gestures are detected while sleeping
+      enum class WakeUpDetection : uint8_t { Software, Sensor };
       enum class Colors : uint8_t {
         White,
         Silver,
@@ -290,6 +292,17 @@ namespace Pinetime {
         return getWakeUpModes()[static_cast<size_t>(mode)];
       }
 
+      void SetWakeUpDetection(WakeUpDetection detection) {
+        if (detection != settings.wakeUpDetection) {
+          settingsChanged = true;
+        }
+        settings.wakeUpDetection = detection;
+      };
+
+      WakeUpDetection GetWakeUpDetection() const {
+        return settings.wakeUpDetection;
+      };
+
       void SetBrightness(Controllers::BrightnessController::Levels level) {
         if (level != settings.brightLevel) {
           settingsChanged = true;
@@ -334,7 +347,7 @@ namespace Pinetime {
     private:
       Pinetime::Controllers::FS& fs;
 
-      static constexpr uint32_t settingsVersion = 0x0007;
+      static constexpr uint32_t settingsVersion = 0x0008;
 
       struct SettingsData {
         uint32_t version = settingsVersion;
@@ -355,6 +368,7 @@ namespace Pinetime {
 
         std::bitset<5> wakeUpMode {0};
         uint16_t shakeWakeThreshold = 150;
+        WakeUpDetection wakeUpDetection = WakeUpDetection::Software;
 
         Controllers::BrightnessController::Levels brightLevel = Controllers::BrightnessController::Levels::Medium;
 
@@ -1,5 +1,6 @@
 #include "displayapp/DisplayApp.h"
 #include <libraries/log/nrf_log.h>
+#include <algorithm>
 #include "displayapp/screens/HeartRate.h"
 #include "displayapp/screens/Motion.h"
 #include "displayapp/screens/Timer.h"
@@ -8,6 +9,7 @@
 #include "components/ble/BleController.h"
 #include "components/datetime/DateTimeController.h"
 #include "components/ble/NotificationManager.h"
+#include "components/ble/FrameProfilerService.h"
 #include "components/motion/MotionController.h"
 #include "components/motor/MotorController.h"
 #include "displayapp/screens/ApplicationList.h"
@@ -45,6 +47,7 @@
 #include "displayapp/screens/settings/SettingTimeFormat.h"
 #include "displayapp/screens/settings/SettingWeatherFormat.h"
 #include "displayapp/screens/settings/SettingWakeUp.h"
+#include "displayapp/screens/settings/SettingWakeUpDetection.h"
 #include "displayapp/screens/settings/SettingDisplay.h"
 #include "displayapp/screens/settings/SettingSteps.h"
 #include "displayapp/screens/settings/SettingSetDateTime.h"
@@ -207,6 +210,19 @@ void DisplayApp::Refresh() {
     return lv_disp_get_inactive_time(nullptr) >= pdMS_TO_TICKS(settingsController.GetScreenTimeOut());
   };
 
+  // Time until the screen must be dimmed or put to sleep, the queue timeout never exceeds it
+  auto TimeUntilScreenTimeout = [this]() -> TickType_t {
+    const uint32_t inactiveTime = lv_disp_get_inactive_time(nullptr);
+    uint32_t timeout = pdMS_TO_TICKS(settingsController.GetScreenTimeOut());
+    if (systemTask->IsSleepDisabled()) {
+      return timeout;
+    }
+    if (inactiveTime < pdMS_TO_TICKS(settingsController.GetScreenTimeOut() - 2000)) {
+      timeout = pdMS_TO_TICKS(settingsController.GetScreenTimeOut() - 2000);
+    }
+    return (inactiveTime < timeout) ? (timeout - inactiveTime) : 0;
+  };
+
   TickType_t queueTimeout;
   switch (state) {
     case States::Idle:
@@ -216,7 +232,19 @@ void DisplayApp::Refresh() {
       if (!currentScreen->IsRunning()) {
         LoadPreviousScreen();
       }
-      queueTimeout = lv_task_handler();
+      if (screenRefreshPending.exchange(false)) {
+        const uint32_t deferredUpdates = lvgl.GetDamageStats().deferredUpdates;
+        currentScreen->Refresh();
+        screenRefreshEvents = currentScreen->RefreshEvents();
+        if (lvgl.GetDamageStats().deferredUpdates != deferredUpdates) {
+          // Some widgets were not updated to keep this frame within the damage budget, retry on the next one
+          screenRefreshPending = true;
+        }
+      }
+      queueTimeout = std::min<TickType_t>(lvgl.RunTasks(), TimeUntilScreenTimeout());
+      if (screenRefreshPending) {
+        queueTimeout = std::min<TickType_t>(queueTimeout, LV_DISP_DEF_REFR_PERIOD);
+      }
 
       if (!systemTask->IsSleepDisabled() && IsPastDimTime()) {
         if (!isDimmed) {
@@ -236,7 +264,13 @@ void DisplayApp::Refresh() {
   }
 
   Messages msg;
-  if (xQueueReceive(msgQueue, &msg, queueTimeout) == pdTRUE) {
+  const TickType_t sleepStart = xTaskGetTickCount();
+  const BaseType_t received = xQueueReceive(msgQueue, &msg, queueTimeout);
+  if (state == States::Running) {
+    sleepStats.screenSleepTicks += xTaskGetTickCount() - sleepStart;
+    sleepStats.screenWakeups++;
+  }
+  if (received == pdTRUE) {
     switch (msg) {
       case Messages::DimScreen:
         DimScreen();
@@ -266,6 +300,9 @@ void DisplayApp::Refresh() {
       case Messages::NewNotification:
         LoadNewScreen(Apps::NotificationsPreview, DisplayApp::FullRefreshDirections::Down);
         break;
+      case Messages::RefreshScreen:
+        // The screen is refreshed at the beginning of the next iteration
+        break;
       case Messages::TimerDone:
         if (state != States::Running) {
           PushMessageToSystemTask(System::Messages::GoToRunning);
@@ -435,6 +472,9 @@ void DisplayApp::LoadScreen(Apps app, DisplayApp::FullRefreshDirections directio
   motorController.StopRinging();
 
   currentScreen.reset(nullptr);
+  lvgl.ReleaseDrawBuffers();
+  lvgl.ResetScreenDamage();
+  ResetScreenSleepStats();
   SetFullRefresh(direction);
 
   switch (app) {
@@ -528,6 +568,9 @@ void DisplayApp::LoadScreen(Apps app, DisplayApp::FullRefreshDirections directio
     case Apps::SettingWakeUp:
       currentScreen = std::make_unique<Screens::SettingWakeUp>(settingsController);
       break;
+    case Apps::SettingWakeUpDetection:
+      currentScreen = std::make_unique<Screens::SettingWakeUpDetection>(settingsController);
+      break;
     case Apps::SettingHeartRate:
       currentScreen = std::make_unique<Screens::SettingHeartRate>(settingsController);
       break;
@@ -563,7 +606,8 @@ void DisplayApp::LoadScreen(Apps app, DisplayApp::FullRefreshDirections directio
                                                             bleController,
                                                             watchdog,
                                                             motionController,
-                                                            touchPanel);
+                                                            touchPanel,
+                                                            lvgl);
       break;
     case Apps::FlashLight:
       currentScreen = std::make_unique<Screens::FlashLight>(*systemTask, brightnessController);
@@ -580,6 +624,8 @@ void DisplayApp::LoadScreen(Apps app, DisplayApp::FullRefreshDirections directio
       break;
     }
   }
+  screenRefreshEvents = currentScreen->RefreshEvents();
+  lvgl.BorrowDrawBuffers();
   currentApp = app;
 }
 
@@ -595,7 +641,7 @@ void DisplayApp::PushMessage(Messages msg) {
     // Make xQueueSend() non-blocking if the message is a Notification message. We do this to avoid
     // deadlock between SystemTask and DisplayApp when their respective message queues are getting full
     // when a lot of notifications are received on a very short time span.
-    if (msg == Messages::NewNotification) {
+    if (msg == Messages::NewNotification || msg == Messages::RefreshScreen) {
       timeout = static_cast<TickType_t>(0);
     }
 
@@ -603,6 +649,28 @@ void DisplayApp::PushMessage(Messages msg) {
   }
 }
 
+void DisplayApp::ResetScreenSleepStats() {
+  NRF_LOG_INFO("[DisplayApp] app %d: %lu wake-ups, average sleep %lu ms",
+               static_cast<int>(currentApp),
+               sleepStats.screenWakeups,
+               SleepStats::AverageSleepMs(sleepStats.screenSleepTicks, sleepStats.screenWakeups));
+  sleepStats.previousApp = currentApp;
+  sleepStats.previousScreenWakeups = sleepStats.screenWakeups;
+  sleepStats.previousScreenSleepTicks = sleepStats.screenSleepTicks;
+  sleepStats.screenWakeups = 0;
+  sleepStats.screenSleepTicks = 0;
+}
+
+void DisplayApp::OnChange(Controllers::ChangeEvents event) {
+  if ((screenRefreshEvents & Controllers::ToMask(event)) == 0) {
+    return;
+  }
+  // Only one refresh message is queued at a time, the screen reads the latest state of all the controllers
+  if (!screenRefreshPending.exchange(true)) {
+    PushMessage(Messages::RefreshScreen);
+  }
+}
+
 void DisplayApp::SetFullRefresh(DisplayApp::FullRefreshDirections direction) {
   switch (direction) {
     case DisplayApp::FullRefreshDirections::Down:
@@ -651,6 +719,10 @@ void DisplayApp::Register(Pinetime::Controllers::NavigationService* NavigationSe
   this->controllers.navigationService = NavigationService;
 }
 
+void DisplayApp::Register(Pinetime::Controllers::FrameProfilerService* frameProfilerService) {
+  frameProfilerService->SetFrameProfiler(&lvgl.GetFrameProfiler());
+}
+
 void DisplayApp::ApplyBrightness() {
   auto brightness = settingsController.GetBrightness();
   if (brightness != Controllers::BrightnessController::Levels::Low && brightness != Controllers::BrightnessController::Levels::Medium &&
@@ -2,6 +2,7 @@
 #include <FreeRTOS.h>
 #include <queue.h>
 #include <task.h>
+#include <atomic>
 #include <memory>
 #include <systemtask/Messages.h>
 #include "displayapp/apps/Apps.h"
@@ -14,6 +15,7 @@
 #include "displayapp/screens/Screen.h"
 #include "components/timer/Timer.h"
 #include "components/alarm/AlarmController.h"
+#include "components/ChangeListener.h"
 #include "touchhandler/TouchHandler.h"
 
 #include "displayapp/Messages.h"
@@ -40,6 +42,7 @@ namespace Pinetime {
     class MotionController;
     class TouchHandler;
     class SimpleWeatherService;
+    class FrameProfilerService;
   }
 
   namespace System {
@@ -47,11 +50,27 @@ namespace Pinetime {
   };
 
   namespace Applications {
-    class DisplayApp {
+    class DisplayApp : public Controllers::ChangeListener {
     public:
       enum class States { Idle, Running };
       enum class FullRefreshDirections { None, Up, Down, Left, Right, LeftAnim, RightAnim };
 
+      // Time the display task spent waiting for a message while the display was on
+      struct SleepStats {
+        uint32_t screenWakeups = 0;
+        uint32_t screenSleepTicks = 0;
+        Apps previousApp = Apps::None;
+        uint32_t previousScreenWakeups = 0;
+        uint32_t previousScreenSleepTicks = 0;
+
+        static uint32_t AverageSleepMs(uint32_t sleepTicks, uint32_t wakeups) {
+          if (wakeups == 0) {
+            return 0;
+          }
+          return static_cast<uint32_t>((static_cast<uint64_t>(sleepTicks) * 1000) / (static_cast<uint64_t>(configTICK_RATE_HZ) * wakeups));
+        }
+      };
+
       DisplayApp(Drivers::St7789& lcd,
                  const Drivers::Cst816S&,
                  const Controllers::Battery& batteryController,
@@ -78,6 +97,13 @@ namespace Pinetime {
       void Register(Pinetime::Controllers::SimpleWeatherService* weatherService);
       void Register(Pinetime::Controllers::MusicService* musicService);
       void Register(Pinetime::Controllers::NavigationService* NavigationService);
+      void Register(Pinetime::Controllers::FrameProfilerService* frameProfilerService);
+
+      void OnChange(Controllers::ChangeEvents event) override;
+
+      const SleepStats& GetSleepStats() const {
+        return sleepStats;
+      }
 
     private:
       Pinetime::Drivers::St7789& lcd;
@@ -111,6 +137,12 @@ namespace Pinetime {
       static constexpr uint8_t itemSize = 1;
 
       std::unique_ptr<Screens::Screen> currentScreen;
+      // Controller changes the current screen is refreshed on, and whether such a refresh is pending
+      std::atomic<Controllers::ChangeEventMask> screenRefreshEvents {0};
+      std::atomic<bool> screenRefreshPending {false};
+
+      SleepStats sleepStats;
+      void ResetScreenSleepStats();
 
       Apps currentApp = Apps::None;
       Apps returnToApp = Apps::None;
@@ -130,3 +130,9 @@ void DisplayApp::Register(Pinetime::Controllers::MusicService* /*musicService*/)
 
 void DisplayApp::Register(Pinetime::Controllers::NavigationService* /*NavigationService*/) {
 }
+
+void DisplayApp::Register(Pinetime::Controllers::FrameProfilerService* /*frameProfilerService*/) {
+}
+
+void DisplayApp::OnChange(Pinetime::Controllers::ChangeEvents /*event*/) {
+}
@@ -12,6 +12,7 @@
 #include "displayapp/TouchEvents.h"
 #include "displayapp/apps/Apps.h"
 #include "displayapp/Messages.h"
+#include "components/ChangeListener.h"
 
 namespace Pinetime {
   namespace Drivers {
@@ -36,6 +37,7 @@ namespace Pinetime {
     class SimpleWeatherService;
     class MusicService;
     class NavigationService;
+    class FrameProfilerService;
   }
 
   namespace System {
@@ -43,7 +45,7 @@ namespace Pinetime {
   };
 
   namespace Applications {
-    class DisplayApp {
+    class DisplayApp : public Controllers::ChangeListener {
     public:
       DisplayApp(Drivers::St7789& lcd,
                  const Drivers::Cst816S&,
@@ -71,6 +73,9 @@ namespace Pinetime {
       void Register(Pinetime::Controllers::SimpleWeatherService* weatherService);
       void Register(Pinetime::Controllers::MusicService* musicService);
       void Register(Pinetime::Controllers::NavigationService* NavigationService);
+      void Register(Pinetime::Controllers::FrameProfilerService* frameProfilerService);
+
+      void OnChange(Controllers::ChangeEvents event) override;
 
     private:
       TaskHandle_t taskHandle;
@@ -3,6 +3,8 @@
 
 #include <FreeRTOS.h>
 #include <task.h>
+#include <algorithm>
+#include <libraries/log/nrf_log.h>
 #include "drivers/St7789.h"
 #include "littlefs/lfs.h"
 #include "components/fs/FS.h"
@@ -58,6 +60,11 @@ static void disp_flush(lv_disp_drv_t* disp_drv, const lv_area_t* area, lv_color_
   lvgl->FlushDisplay(area, color_p);
 }
 
+static void monitor(lv_disp_drv_t* disp_drv, uint32_t time, uint32_t /*px*/) {
+  auto* lvgl = static_cast<LittleVgl*>(disp_drv->user_data);
+  lvgl->OnFrameRendered(time);
+}
+
 static void rounder(lv_disp_drv_t* disp_drv, lv_area_t* area) {
   auto* lvgl = static_cast<LittleVgl*>(disp_drv->user_data);
   if (lvgl->GetFullRefresh()) {
@@ -77,6 +84,7 @@ LittleVgl::LittleVgl(Pinetime::Drivers::St7789& lcd, Pinetime::Controllers::FS&
 }
 
 void LittleVgl::Init() {
+  frameProfiler.Init();
   lv_init();
   InitTheme();
   InitDisplay();
@@ -85,8 +93,8 @@ void LittleVgl::Init() {
 }
 
 void LittleVgl::InitDisplay() {
-  lv_disp_buf_init(&disp_buf_2, buf2_1, buf2_2, LV_HOR_RES_MAX * 4); /*Initialize the display buffer*/
-  lv_disp_drv_init(&disp_drv);                                       /*Basic initialization*/
+  lv_disp_buf_init(&disp_buf_2, buf2_1, buf2_2, LV_HOR_RES_MAX * staticBufferLines); /*Initialize the display buffer*/
+  lv_disp_drv_init(&disp_drv);                                                       /*Basic initialization*/
 
   /*Set up the functions to access to your display*/
 
@@ -100,6 +108,7 @@ void LittleVgl::InitDisplay() {
   disp_drv.buffer = &disp_buf_2;
   disp_drv.user_data = this;
   disp_drv.rounder_cb = rounder;
+  disp_drv.monitor_cb = monitor;
 
   /*Finally register the driver*/
   lv_disp_drv_register(&disp_drv);
@@ -147,14 +156,35 @@ void LittleVgl::SetFullRefresh(FullRefreshDirections direction) {
     }
   }
   fullRefresh = true;
+  windowValid = false;
+}
+
+uint16_t LittleVgl::InvalidatedAreaLastLine(const lv_area_t* area) {
+  // LVGL flushes each invalidated area in chunks of a few lines, from top to bottom.
+  // Find the area this chunk is the first one of, to set the address window for all of them at once.
+  const lv_disp_t* disp = _lv_refr_get_disp_refreshing();
+  if (disp != nullptr) {
+    for (uint16_t i = 0; i < disp->inv_p; i++) {
+      const lv_area_t& invalidated = disp->inv_areas[i];
+      if (disp->inv_area_joined[i] == 0 && invalidated.x1 == area->x1 && invalidated.x2 == area->x2 && invalidated.y1 == area->y1) {
+        return invalidated.y2;
+      }
+    }
+  }
+  return area->y2;
 }
 
 void LittleVgl::FlushDisplay(const lv_area_t* area, lv_color_t* color_p) {
   uint16_t y1, y2, width, height = 0;
+  // The address window can only be kept between flushes when the display is not scrolling.
+  // Lateral transitions are drawn in columns without moving the GRAM mapping: the ST7789 can only scroll vertically.
+  const bool canContinueWindow = scrollDirection != FullRefreshDirections::Up && scrollDirection != FullRefreshDirections::Down;
 
+  frameProfiler.StartFlush();
   ulTaskNotifyTake(pdTRUE, 200);
   // Notification is still needed (even if there is a mutex on SPI) because of the DataCommand pin
   // which cannot be set/clear during a transfer.
+  frameProfiler.EndSpiWait();
 
   if ((scrollDirection == LittleVgl::FullRefreshDirections::Down) && (area->y2 == visibleNbLines - 1)) {
     writeOffset = ((writeOffset + totalNbLines) - visibleNbLines) % totalNbLines;
@@ -167,6 +197,9 @@ void LittleVgl::FlushDisplay(const lv_area_t* area, lv_color_t* color_p) {
 
   width = (area->x2 - area->x1) + 1;
   height = (area->y2 - area->y1) + 1;
+  const uint32_t nbPixels = width * height;
+  framePixels += nbPixels;
+  damageStats.screenFlushes++;
 
   if (scrollDirection == LittleVgl::FullRefreshDirections::Down) {
 
@@ -215,6 +248,7 @@ void LittleVgl::FlushDisplay(const lv_area_t* area, lv_color_t* color_p) {
   }
 
   if (y2 < y1) {
+    windowValid = false;
     height = totalNbLines - y1;
 
     if (height > 0) {
@@ -226,15 +260,226 @@ void LittleVgl::FlushDisplay(const lv_area_t* area, lv_color_t* color_p) {
     height = y2 + 1;
     lcd.DrawBuffer(area->x1, 0, width, height, reinterpret_cast<const uint8_t*>(color_p + pixOffset), width * height * 2);
 
+  } else if (canContinueWindow && windowValid && area->x1 == windowX1 && area->x2 == windowX2 && y1 == windowNextLine &&
+             y2 <= windowLastLine) {
+    const uint16_t patternSize = SolidFillPatternSize(color_p, width * height);
+    if (patternSize > 0) {
+      lcd.ContinueFillBuffer(reinterpret_cast<const uint8_t*>(fillPattern), patternSize * 2, (width * height) / patternSize);
+    } else {
+      lcd.ContinueDrawBuffer(reinterpret_cast<const uint8_t*>(color_p), width * height * 2);
+    }
+    windowNextLine = y2 + 1;
   } else {
-    lcd.DrawBuffer(area->x1, y1, width, height, reinterpret_cast<const uint8_t*>(color_p), width * height * 2);
+    uint16_t lastLine = y2;
+    if (canContinueWindow) {
+      uint16_t areaLastLine = InvalidatedAreaLastLine(area);
+      if (y1 + (areaLastLine - area->y1) < totalNbLines) {
+        lastLine = y1 + (areaLastLine - area->y1);
+      }
+    }
+    const uint16_t patternSize = SolidFillPatternSize(color_p, width * height);
+    if (patternSize > 0) {
+      lcd.FillBuffer(area->x1,
+                     y1,
+                     width,
+                     (lastLine - y1) + 1,
+                     reinterpret_cast<const uint8_t*>(fillPattern),
+                     patternSize * 2,
+                     (width * height) / patternSize);
+    } else {
+      lcd.DrawBuffer(area->x1, y1, width, (lastLine - y1) + 1, reinterpret_cast<const uint8_t*>(color_p), width * height * 2);
+    }
+
+    windowValid = canContinueWindow;
+    windowX1 = area->x1;
+    windowX2 = area->x2;
+    windowNextLine = y2 + 1;
+    windowLastLine = lastLine;
   }
 
+  frameProfiler.EndFlush(nbPixels * sizeof(lv_color_t));
+
   // IMPORTANT!!!
   // Inform the graphics library that you are ready with the flushing
   lv_disp_flush_ready(&disp_drv);
 }
 
+uint16_t LittleVgl::SolidFillPatternSize(const lv_color_t* colors, uint32_t nbPixels) {
+  if (nbPixels < 2 * minFillPatternPixels) {
+    return 0;
+  }
+  for (uint32_t i = 1; i < nbPixels; i++) {
+    if (colors[i].full != colors[0].full) {
+      return 0;
+    }
+  }
+
+  // The largest pattern that evenly divides the area: the fewer the repeats, the fewer the DMA restarts
+  uint16_t patternSize = maxFillPatternPixels;
+  while (nbPixels % patternSize != 0) {
+    patternSize--;
+  }
+  if (patternSize < minFillPatternPixels) {
+    return 0;
+  }
+
+  std::fill_n(fillPattern, patternSize, colors[0]);
+  damageStats.solidFillPixels += nbPixels;
+  return patternSize;
+}
+
+void LittleVgl::OnFrameRendered(uint32_t renderTime) {
+  damageStats.screenRenderTime += renderTime;
+  damageStats.lastFramePixels = framePixels;
+  damageStats.maxFramePixels = std::max(damageStats.maxFramePixels, framePixels);
+  damageStats.screenPixels += framePixels;
+  damageStats.screenFrames++;
+  damageStats.totalPixels += framePixels;
+  framePixels = 0;
+}
+
+void LittleVgl::ResetScreenDamage() {
+  if (damageStats.screenFrames > 0) {
+    NRF_LOG_INFO("[LittleVgl] %lu frames, %lu flushes, %lu ms/frame with %u lines draw buffers",
+                 damageStats.screenFrames,
+                 damageStats.screenFlushes,
+                 damageStats.screenRenderTime / damageStats.screenFrames,
+                 drawBufferLines);
+  }
+  damageStats.previousScreenPixels = damageStats.screenPixels;
+  damageStats.previousScreenFrames = damageStats.screenFrames;
+  damageStats.screenPixels = 0;
+  damageStats.screenFrames = 0;
+  damageStats.screenFlushes = 0;
+  damageStats.screenRenderTime = 0;
+}
+
+void LittleVgl::BorrowDrawBuffers(uint16_t lines) {
+  if (borrowedBuffer1 != nullptr) {
+    return;
+  }
+
+  // Try smaller buffers when the heap is too short for the requested ones.
+  // Transitions inside a screen need the screen to be drawn in equal steps.
+  for (lines = std::min(lines, maxBorrowedBufferLines); lines > staticBufferLines; lines /= 2) {
+    const size_t bufferSize = LV_HOR_RES_MAX * lines * sizeof(lv_color_t);
+    if ((LV_VER_RES_MAX % lines) != 0 || xPortGetFreeHeapSize() < (2 * bufferSize) + borrowHeapReserve) {
+      continue;
+    }
+
+    borrowedBuffer1 = static_cast<lv_color_t*>(pvPortMalloc(bufferSize));
+    borrowedBuffer2 = static_cast<lv_color_t*>(pvPortMalloc(bufferSize));
+    if (borrowedBuffer1 != nullptr && borrowedBuffer2 != nullptr) {
+      borrowedBufferLines = lines;
+      return;
+    }
+
+    // The heap is too fragmented
+    vPortFree(borrowedBuffer1);
+    vPortFree(borrowedBuffer2);
+    borrowedBuffer1 = nullptr;
+    borrowedBuffer2 = nullptr;
+  }
+}
+
+void LittleVgl::ReleaseDrawBuffers() {
+  if (borrowedBuffer1 == nullptr) {
+    return;
+  }
+
+  if (drawBufferLines != staticBufferLines) {
+    SwitchDrawBuffers(buf2_1, buf2_2, staticBufferLines);
+  }
+  vPortFree(borrowedBuffer1);
+  vPortFree(borrowedBuffer2);
+  borrowedBuffer1 = nullptr;
+  borrowedBuffer2 = nullptr;
+  borrowedBufferLines = 0;
+}
+
+void LittleVgl::SwitchDrawBuffers(lv_color_t* buffer1, lv_color_t* buffer2, uint16_t lines) {
+  // The DMA may still be reading the last flushed buffer: wait for it like FlushDisplay() does,
+  // and give the notification back for the next flush
+  ulTaskNotifyTake(pdTRUE, 200);
+  lv_disp_buf_init(&disp_buf_2, buffer1, buffer2, LV_HOR_RES_MAX * lines);
+  drawBufferLines = lines;
+  xTaskNotifyGive(xTaskGetCurrentTaskHandle());
+}
+
+bool LittleVgl::HasDamageBudget() {
+  if (damageBudget == 0) {
+    return true;
+  }
+
+  const lv_disp_t* disp = lv_disp_get_default();
+  uint32_t pendingPixels = 0;
+  for (uint16_t i = 0; i < disp->inv_p; i++) {
+    if (disp->inv_area_joined[i] == 0) {
+      pendingPixels += lv_area_get_size(&disp->inv_areas[i]);
+    }
+  }
+
+  if (pendingPixels < damageBudget) {
+    return true;
+  }
+  damageStats.deferredUpdates++;
+  return false;
+}
+
+uint32_t LittleVgl::RunTasks() {
+  // Vertical transitions draw the new screen in steps of the size of the buffers,
+  // so the borrowed buffers are only used once the transition is over.
+  if (borrowedBuffer1 != nullptr && drawBufferLines != borrowedBufferLines && scrollDirection == FullRefreshDirections::None) {
+    SwitchDrawBuffers(borrowedBuffer1, borrowedBuffer2, borrowedBufferLines);
+  }
+  CoalesceTasks();
+  frameProfiler.StartFrame();
+  const uint32_t timeUntilNextTask = lv_task_handler();
+  frameProfiler.EndFrame();
+  if (!IsIdle()) {
+    return timeUntilNextTask;
+  }
+  return TimeUntilNextScreenTask();
+}
+
+bool LittleVgl::IsIdle() const {
+  // The release of the touch must be read by the input device before going idle
+  if (tapped || reportedPressed || lv_anim_count_running() > 0) {
+    return false;
+  }
+  return lv_disp_get_default()->inv_p == 0;
+}
+
+bool LittleVgl::IsScreenTask(const lv_task_t* task) {
+  const lv_disp_t* disp = lv_disp_get_default();
+  const lv_indev_t* indev = lv_indev_get_next(nullptr);
+  return task->prio != LV_TASK_PRIO_OFF && task != disp->refr_task && (indev == nullptr || task != indev->driver.read_task);
+}
+
+void LittleVgl::CoalesceTasks() {
+  for (lv_task_t* task = lv_task_get_next(nullptr); task != nullptr; task = lv_task_get_next(task)) {
+    if (!IsScreenTask(task) || task->period < minCoalescedPeriod) {
+      continue;
+    }
+    const uint32_t elapsed = lv_tick_elaps(task->last_run);
+    if (elapsed < task->period && task->period - elapsed <= task->period / coalescingRatio) {
+      lv_task_ready(task);
+    }
+  }
+}
+
+uint32_t LittleVgl::TimeUntilNextScreenTask() {
+  uint32_t timeUntilNextTask = NoDeadline;
+  for (lv_task_t* task = lv_task_get_next(nullptr); task != nullptr; task = lv_task_get_next(task)) {
+    if (!IsScreenTask(task)) {
+      continue;
+    }
+    const uint32_t elapsed = lv_tick_elaps(task->last_run);
+    timeUntilNextTask = std::min(timeUntilNextTask, (elapsed < task->period) ? task->period - elapsed : 0);
+  }
+  return timeUntilNextTask;
+}
+
 void LittleVgl::SetNewTouchPoint(int16_t x, int16_t y, bool contact) {
   if (contact) {
     if (!isCancelled) {
@@ -268,5 +513,6 @@ bool LittleVgl::GetTouchPadInfo(lv_indev_data_t* ptr) {
   } else {
     ptr->state = LV_INDEV_STATE_REL;
   }
+  reportedPressed = tapped;
   return false;
 }
@@ -2,6 +2,15 @@
 
 #include <lvgl/lvgl.h>
 #include <components/fs/FS.h>
+#include "components/profiler/FrameProfiler.h"
+
+#ifndef DISPLAY_DRAW_BUFFER_LINES
+  #define DISPLAY_DRAW_BUFFER_LINES 4
+#endif
+
+#ifndef DISPLAY_BORROWED_DRAW_BUFFER_LINES
+  #define DISPLAY_BORROWED_DRAW_BUFFER_LINES 16
+#endif
 
 namespace Pinetime {
   namespace Drivers {
@@ -12,6 +21,21 @@ namespace Pinetime {
     class LittleVgl {
     public:
       enum class FullRefreshDirections { None, Up, Down, Left, Right, LeftAnim, RightAnim };
+
+      // Number of pixels pushed to the display
+      struct DamageStats {
+        uint32_t lastFramePixels = 0;
+        uint32_t maxFramePixels = 0;
+        uint32_t screenPixels = 0;
+        uint32_t screenFrames = 0;
+        uint32_t previousScreenPixels = 0;
+        uint32_t previousScreenFrames = 0;
+        uint32_t totalPixels = 0;
+        uint32_t deferredUpdates = 0;
+        uint32_t solidFillPixels = 0;
+        uint32_t screenFlushes = 0;
+        uint32_t screenRenderTime = 0;
+      };
       LittleVgl(Pinetime::Drivers::St7789& lcd, Pinetime::Controllers::FS& filesystem);
 
       LittleVgl(const LittleVgl&) = delete;
@@ -27,6 +51,42 @@ namespace Pinetime {
       void SetNewTouchPoint(int16_t x, int16_t y, bool contact);
       void CancelTap();
 
+      void OnFrameRendered(uint32_t renderTime);
+      // Moves the counters of the current screen to the previous screen ones
+      void ResetScreenDamage();
+      const DamageStats& GetDamageStats() const {
+        return damageStats;
+      }
+
+      // Number of pixels per frame above which non-critical updates should be deferred (0 = no limit)
+      void SetDamageBudget(uint32_t pixels) {
+        damageBudget = pixels;
+      }
+
+      // Returns false when the areas already invalidated for the next frame exceed the damage budget.
+      // Screens call this before updating non-critical widgets and retry on the next refresh if it fails.
+      bool HasDamageBudget();
+
+      // Allocates larger draw buffers from the heap for the current screen, so that it is rendered in fewer flushes.
+      // The buffers are only allocated if enough heap is left for the screen afterwards, and are used
+      // once the current transition is over. Must be called after the screen is created.
+      void BorrowDrawBuffers(uint16_t lines = maxBorrowedBufferLines);
+      // Switches back to the static draw buffers and frees the borrowed ones. Must be called before the next screen is created.
+      void ReleaseDrawBuffers();
+      uint16_t GetDrawBufferLines() const {
+        return drawBufferLines;
+      }
+
+      const Pinetime::Controllers::FrameProfiler& GetFrameProfiler() const {
+        return frameProfiler;
+      }
+
+      // Runs the LVGL tasks that are due and returns the time until LVGL needs to run again (NoDeadline if it doesn't).
+      // While nothing is being drawn, animated or touched, only the deadlines of the screen tasks are taken into account,
+      // so the display task can sleep until the earliest one instead of waking up every display refresh period.
+      uint32_t RunTasks();
+      static constexpr uint32_t NoDeadline = UINT32_MAX;
+
       bool GetFullRefresh() {
         bool returnValue = fullRefresh;
         if (fullRefresh) {
@@ -39,31 +99,70 @@ namespace Pinetime {
       void InitDisplay();
       void InitTouchpad();
       void InitFileSystem();
+      uint16_t InvalidatedAreaLastLine(const lv_area_t* area);
+      bool IsIdle() const;
+      uint16_t SolidFillPatternSize(const lv_color_t* colors, uint32_t nbPixels);
+      void SwitchDrawBuffers(lv_color_t* buffer1, lv_color_t* buffer2, uint16_t lines);
+      static bool IsScreenTask(const lv_task_t* task);
+      static void CoalesceTasks();
+      static uint32_t TimeUntilNextScreenTask();
 
       Pinetime::Drivers::St7789& lcd;
       Pinetime::Controllers::FS& filesystem;
 
       lv_disp_buf_t disp_buf_2;
-      lv_color_t buf2_1[LV_HOR_RES_MAX * 4];
-      lv_color_t buf2_2[LV_HOR_RES_MAX * 4];
+      static constexpr uint16_t staticBufferLines = DISPLAY_DRAW_BUFFER_LINES;
+      static_assert(LV_VER_RES_MAX % staticBufferLines == 0, "Vertical transitions need the screen to be drawn in equal steps");
+      lv_color_t buf2_1[LV_HOR_RES_MAX * staticBufferLines];
+      lv_color_t buf2_2[LV_HOR_RES_MAX * staticBufferLines];
+
+      // Draw buffers borrowed from the heap. They are only allocated if at least borrowHeapReserve bytes
+      // of heap are still free afterwards, so that the screen can keep creating objects.
+      static constexpr uint16_t maxBorrowedBufferLines = DISPLAY_BORROWED_DRAW_BUFFER_LINES;
+      static constexpr size_t borrowHeapReserve = 8 * 1024;
+      lv_color_t* borrowedBuffer1 = nullptr;
+      lv_color_t* borrowedBuffer2 = nullptr;
+      uint16_t borrowedBufferLines = 0;
+      uint16_t drawBufferLines = staticBufferLines;
 
       lv_disp_drv_t disp_drv;
 
       bool fullRefresh = false;
-      static constexpr uint8_t nbWriteLines = 4;
       static constexpr uint16_t totalNbLines = 320;
       static constexpr uint16_t visibleNbLines = 240;
 
-      static constexpr uint8_t MaxScrollOffset() {
-        return LV_VER_RES_MAX - nbWriteLines;
-      }
+      // Screen tasks with at least this period may run up to 1/coalescingRatio of their period early,
+      // so that tasks with close deadlines share a single wake-up of the display task
+      static constexpr uint32_t minCoalescedPeriod = 500;
+      static constexpr uint32_t coalescingRatio = 8;
+
+      static constexpr uint32_t defaultDamageBudget = (LV_HOR_RES_MAX * LV_VER_RES_MAX) / 4;
+      uint32_t damageBudget = defaultDamageBudget;
+      uint32_t framePixels = 0;
+      DamageStats damageStats;
+      Pinetime::Controllers::FrameProfiler frameProfiler;
 
       FullRefreshDirections scrollDirection = FullRefreshDirections::None;
       uint16_t writeOffset = 0;
       uint16_t scrollOffset = 0;
 
+      // Address window of the display (in GRAM lines) that consecutive flushes of the same
+      // invalidated area are written into, so that the window is only sent once per area.
+      bool windowValid = false;
+      lv_coord_t windowX1 = 0;
+      lv_coord_t windowX2 = 0;
+      uint16_t windowNextLine = 0;
+      uint16_t windowLastLine = 0;
+
+      // Single color areas are sent by repeating this pattern instead of reading the whole LVGL buffer.
+      // The pattern must fit in a single EasyDMA transfer and evenly divide the area.
+      static constexpr uint16_t maxFillPatternPixels = 127;
+      static constexpr uint16_t minFillPatternPixels = 16;
+      lv_color_t fillPattern[maxFillPatternPixels];
+
       lv_point_t touchPoint = {};
       bool tapped = false;
+      bool reportedPressed = false;
       bool isCancelled = false;
     };
   }
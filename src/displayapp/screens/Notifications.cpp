@@ -65,7 +65,7 @@ Notifications::Notifications(DisplayApp* app,
     interacted = false;
   }
 
-  taskRefresh = lv_task_create(RefreshTaskCallback, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, this);
+  taskRefresh = lv_task_create(RefreshTaskCallback, RefreshPeriods::Frame, LV_TASK_PRIO_MID, this);
 }
 
 Notifications::~Notifications() {
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include "displayapp/TouchEvents.h"
+#include "components/ChangeListener.h"
 #include <lvgl/lvgl.h>
 
 namespace Pinetime {
@@ -9,18 +10,37 @@ namespace Pinetime {
     class DisplayApp;
 
     namespace Screens {
-      class Screen {
-      private:
-        virtual void Refresh() {
-        }
+      // Periods of the screen refresh tasks. The display task sleeps until the earliest deadline of these tasks,
+      // so screens should use the slowest period matching what they display.
+      namespace RefreshPeriods {
+        // Animations, games and live sensor graphs
+        constexpr uint32_t Frame = LV_DISP_DEF_REFR_PERIOD;
+        // Counters displaying tenths of a second, values polled from sensors
+        constexpr uint32_t Fast = 100;
+        // Clocks and counters displaying seconds
+        constexpr uint32_t Second = 1000;
+        // Clocks displaying minutes
+        constexpr uint32_t Minute = 60 * 1000;
+      }
 
+      class Screen {
       public:
         explicit Screen() = default;
 
         virtual ~Screen() = default;
 
+        virtual void Refresh() {
+        }
+
         static void RefreshTaskCallback(lv_task_t* task);
 
+        // Controller changes this screen displays. DisplayApp calls Refresh() when one of them occurs,
+        // so screens returning a non-empty mask don't need to poll the controllers from an lv_task.
+        // The mask is read again after each Refresh(), it can depend on what the screen currently shows.
+        virtual Controllers::ChangeEventMask RefreshEvents() const {
+          return 0;
+        }
+
         bool IsRunning() const {
           return running;
         }
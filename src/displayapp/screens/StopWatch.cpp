@@ -74,7 +74,7 @@ StopWatch::StopWatch(System::SystemTask& systemTask) : systemTask {systemTask} {
 
   SetInterfaceStopped();
 
-  taskRefresh = lv_task_create(RefreshTaskCallback, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, this);
+  taskRefresh = lv_task_create(RefreshTaskCallback, RefreshPeriods::Fast, LV_TASK_PRIO_MID, this);
 }
 
 StopWatch::~StopWatch() {
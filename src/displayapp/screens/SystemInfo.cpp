@@ -13,6 +13,7 @@
 #include "components/datetime/DateTimeController.h"
 #include "components/motion/MotionController.h"
 #include "drivers/Watchdog.h"
+#include "displayapp/LittleVgl.h"
 #include "displayapp/InfiniTimeTheme.h"
 
 using namespace Pinetime::Applications::Screens;
@@ -38,7 +39,8 @@ SystemInfo::SystemInfo(Pinetime::Applications::DisplayApp* app,
                        const Pinetime::Controllers::Ble& bleController,
                        const Pinetime::Drivers::Watchdog& watchdog,
                        Pinetime::Controllers::MotionController& motionController,
-                       const Pinetime::Drivers::Cst816S& touchPanel)
+                       const Pinetime::Drivers::Cst816S& touchPanel,
+                       const Pinetime::Components::LittleVgl& lvgl)
   : app {app},
     dateTimeController {dateTimeController},
     batteryController {batteryController},
@@ -47,6 +49,7 @@ SystemInfo::SystemInfo(Pinetime::Applications::DisplayApp* app,
     watchdog {watchdog},
     motionController {motionController},
     touchPanel {touchPanel},
+    lvgl {lvgl},
     screens {app,
              0,
              {[this]() -> std::unique_ptr<Screen> {
@@ -63,6 +66,12 @@ SystemInfo::SystemInfo(Pinetime::Applications::DisplayApp* app,
               },
               [this]() -> std::unique_ptr<Screen> {
                 return CreateScreen5();
+              },
+              [this]() -> std::unique_ptr<Screen> {
+                return CreateScreen6();
+              },
+              [this]() -> std::unique_ptr<Screen> {
+                return CreateScreen7();
               }},
              Screens::ScreenListModes::UpDown} {
 }
@@ -95,7 +104,7 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen1() {
                         BootloaderVersion::VersionString());
   lv_label_set_align(label, LV_LABEL_ALIGN_CENTER);
   lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
-  return std::make_unique<Screens::Label>(0, 5, label);
+  return std::make_unique<Screens::Label>(0, 7, label);
 }
 
 std::unique_ptr<Screen> SystemInfo::CreateScreen2() {
@@ -174,7 +183,7 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen2() {
                         touchPanel.GetFwVersion(),
                         TARGET_DEVICE_NAME);
   lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
-  return std::make_unique<Screens::Label>(1, 5, label);
+  return std::make_unique<Screens::Label>(1, 7, label);
 }
 
 extern int mallocFailedCount;
@@ -207,7 +216,7 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen3() {
                         mallocFailedCount,
                         stackOverflowCount);
   lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
-  return std::make_unique<Screens::Label>(2, 5, label);
+  return std::make_unique<Screens::Label>(2, 7, label);
 }
 
 bool SystemInfo::sortById(const TaskStatus_t& lhs, const TaskStatus_t& rhs) {
@@ -268,10 +277,67 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen4() {
     }
     lv_table_set_cell_value(infoTask, i + 1, 3, buffer);
   }
-  return std::make_unique<Screens::Label>(3, 5, infoTask);
+  return std::make_unique<Screens::Label>(3, 7, infoTask);
 }
 
 std::unique_ptr<Screen> SystemInfo::CreateScreen5() {
+  const auto& damage = lvgl.GetDamageStats();
+  const auto& sleep = app->GetSleepStats();
+
+  lv_obj_t* label = lv_label_create(lv_scr_act(), nullptr);
+  lv_label_set_recolor(label, true);
+  lv_label_set_text_fmt(label,
+                        "#FFFF00 Display#\n\n"
+                        "#808080 Pixels pushed#\n"
+                        " #808080 Last frame# %lu\n"
+                        " #808080 Max frame# %lu\n"
+                        " #808080 Prev. screen#\n"
+                        "  %lu in %lu frames\n"
+                        " #808080 Total# %lu\n"
+                        " #808080 Solid fill# %lu\n"
+                        "#808080 Deferred upd.# %lu\n"
+                        "#808080 Prev. screen sleep# %lu ms",
+                        damage.lastFramePixels,
+                        damage.maxFramePixels,
+                        damage.previousScreenPixels,
+                        damage.previousScreenFrames,
+                        damage.totalPixels,
+                        damage.solidFillPixels,
+                        damage.deferredUpdates,
+                        DisplayApp::SleepStats::AverageSleepMs(sleep.previousScreenSleepTicks, sleep.previousScreenWakeups));
+  lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
+  return std::make_unique<Screens::Label>(4, 7, label);
+}
+
+std::unique_ptr<Screen> SystemInfo::CreateScreen6() {
+  const auto& profiler = lvgl.GetFrameProfiler();
+  const auto lastFrame = profiler.NbFrames() > 0 ? profiler.GetFrame(0) : Controllers::FrameProfiler::Frame {};
+  const auto average = profiler.Average();
+
+  lv_obj_t* label = lv_label_create(lv_scr_act(), nullptr);
+  lv_label_set_recolor(label, true);
+  lv_label_set_text_fmt(label,
+                        "#FFFF00 Frames# %lu\n\n"
+                        "#808080 Last# / #808080 Avg. of %u#\n"
+                        " #808080 Render# %lu / %lu us\n"
+                        " #808080 Flush# %lu / %lu us\n"
+                        " #808080 SPI wait# %lu / %lu us\n"
+                        " #808080 Sent# %lu / %lu B",
+                        profiler.TotalFrames(),
+                        profiler.NbFrames(),
+                        lastFrame.renderTime,
+                        average.renderTime,
+                        lastFrame.flushTime,
+                        average.flushTime,
+                        lastFrame.spiWaitTime,
+                        average.spiWaitTime,
+                        lastFrame.bytesSent,
+                        average.bytesSent);
+  lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
+  return std::make_unique<Screens::Label>(5, 7, label);
+}
+
+std::unique_ptr<Screen> SystemInfo::CreateScreen7() {
   lv_obj_t* label = lv_label_create(lv_scr_act(), nullptr);
   lv_label_set_recolor(label, true);
   lv_label_set_text_static(label,
@@ -285,5 +351,5 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen5() {
                            "#FFFF00 InfiniTime#");
   lv_label_set_align(label, LV_LABEL_ALIGN_CENTER);
   lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
-  return std::make_unique<Screens::Label>(4, 5, label);
+  return std::make_unique<Screens::Label>(6, 7, label);
 }
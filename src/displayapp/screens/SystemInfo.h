@@ -16,6 +16,10 @@ namespace Pinetime {
     class Watchdog;
   }
 
+  namespace Components {
+    class LittleVgl;
+  }
+
   namespace Applications {
     class DisplayApp;
 
@@ -29,7 +33,8 @@ namespace Pinetime {
                             const Pinetime::Controllers::Ble& bleController,
                             const Pinetime::Drivers::Watchdog& watchdog,
                             Pinetime::Controllers::MotionController& motionController,
-                            const Pinetime::Drivers::Cst816S& touchPanel);
+                            const Pinetime::Drivers::Cst816S& touchPanel,
+                            const Pinetime::Components::LittleVgl& lvgl);
         ~SystemInfo() override;
         bool OnTouchEvent(TouchEvents event) override;
 
@@ -42,8 +47,9 @@ namespace Pinetime {
         const Pinetime::Drivers::Watchdog& watchdog;
         Pinetime::Controllers::MotionController& motionController;
         const Pinetime::Drivers::Cst816S& touchPanel;
+        const Pinetime::Components::LittleVgl& lvgl;
 
-        ScreenList<5> screens;
+        ScreenList<7> screens;
 
         static bool sortById(const TaskStatus_t& lhs, const TaskStatus_t& rhs);
 
@@ -52,6 +58,8 @@ namespace Pinetime {
         std::unique_ptr<Screen> CreateScreen3();
         std::unique_ptr<Screen> CreateScreen4();
         std::unique_ptr<Screen> CreateScreen5();
+        std::unique_ptr<Screen> CreateScreen6();
+        std::unique_ptr<Screen> CreateScreen7();
       };
     }
   }
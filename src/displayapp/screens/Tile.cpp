@@ -84,7 +84,7 @@ Tile::Tile(uint8_t screenID,
   btnm1->user_data = this;
   lv_obj_set_event_cb(btnm1, event_handler);
 
-  taskUpdate = lv_task_create(lv_update_task, 500, LV_TASK_PRIO_MID, this);
+  taskUpdate = lv_task_create(lv_update_task, RefreshPeriods::Second, LV_TASK_PRIO_MID, this);
 
   UpdateScreen();
 }
@@ -71,7 +71,7 @@ Timer::Timer(Controllers::Timer& timerController, Controllers::MotorController&
     SetTimerStopped();
   }
 
-  taskRefresh = lv_task_create(RefreshTaskCallback, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, this);
+  taskRefresh = lv_task_create(RefreshTaskCallback, RefreshPeriods::Frame, LV_TASK_PRIO_MID, this);
 }
 
 Timer::~Timer() {
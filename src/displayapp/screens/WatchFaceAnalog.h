@@ -35,6 +35,13 @@ namespace Pinetime {
 
         void Refresh() override;
 
+        Controllers::ChangeEventMask RefreshEvents() const override {
+          return Controllers::ToMask(Controllers::ChangeEvents::Second,
+                                     Controllers::ChangeEvents::Battery,
+                                     Controllers::ChangeEvents::Ble,
+                                     Controllers::ChangeEvents::Notification);
+        }
+
       private:
         uint8_t sHour, sMinute, sSecond;
 
@@ -84,8 +91,6 @@ namespace Pinetime {
 
         void UpdateClock();
         void SetBatteryIcon();
-
-        lv_task_t* taskRefresh;
       };
     }
 
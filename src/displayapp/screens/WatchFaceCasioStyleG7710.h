@@ -39,6 +39,15 @@ namespace Pinetime {
 
         void Refresh() override;
 
+        Controllers::ChangeEventMask RefreshEvents() const override {
+          return Controllers::ToMask(Controllers::ChangeEvents::Minute,
+                                     Controllers::ChangeEvents::Battery,
+                                     Controllers::ChangeEvents::Ble,
+                                     Controllers::ChangeEvents::Notification,
+                                     Controllers::ChangeEvents::HeartRate,
+                                     Controllers::ChangeEvents::Steps);
+        }
+
         static bool IsAvailable(Pinetime::Controllers::FS& filesystem);
 
       private:
@@ -96,7 +105,6 @@ namespace Pinetime {
         Controllers::HeartRateController& heartRateController;
         Controllers::MotionController& motionController;
 
-        lv_task_t* taskRefresh;
         lv_font_t* font_dot40 = nullptr;
         lv_font_t* font_segment40 = nullptr;
         lv_font_t* font_segment115 = nullptr;
@@ -23,6 +23,10 @@ namespace Pinetime {
     class Timer;
   }
 
+  namespace Components {
+    class LittleVgl;
+  }
+
   namespace Applications {
     namespace Screens {
 
@@ -36,11 +40,27 @@ namespace Pinetime {
                          Controllers::HeartRateController& heartRateController,
                          Controllers::MotionController& motionController,
                          Controllers::SimpleWeatherService& weather,
-                         Controllers::Timer& timer);
+                         Controllers::Timer& timer,
+                         Components::LittleVgl& lvgl);
         ~WatchFaceDigital() override;
 
         void Refresh() override;
 
+        Controllers::ChangeEventMask RefreshEvents() const override {
+          auto events = Controllers::ToMask(Controllers::ChangeEvents::Minute,
+                                            Controllers::ChangeEvents::Battery,
+                                            Controllers::ChangeEvents::Ble,
+                                            Controllers::ChangeEvents::Notification,
+                                            Controllers::ChangeEvents::HeartRate,
+                                            Controllers::ChangeEvents::Steps,
+                                            Controllers::ChangeEvents::Weather);
+          // The status icons show the remaining time of a running timer down to the second
+          if (timer.IsRunning()) {
+            events |= Controllers::ToMask(Controllers::ChangeEvents::Second);
+          }
+          return events;
+        }
+
       private:
         uint8_t displayedHour = -1;
         uint8_t displayedMinute = -1;
@@ -77,8 +97,8 @@ namespace Pinetime {
         Controllers::MotionController& motionController;
         Controllers::SimpleWeatherService& weatherService;
         Controllers::Timer& timer;
+        Components::LittleVgl& lvgl;
 
-        lv_task_t* taskRefresh;
         Widgets::StatusIcons statusIcons;
       };
     }
@@ -97,7 +117,8 @@ namespace Pinetime {
                                              controllers.heartRateController,
                                              controllers.motionController,
                                              *controllers.weatherController,
-                                             controllers.timer);
+                                             controllers.timer,
+                                             controllers.lvgl);
       };
 
       static bool IsAvailable(Pinetime::Controllers::FS& /*filesystem*/) {
@@ -296,7 +296,7 @@ WatchFaceInfineat::WatchFaceInfineat(Controllers::DateTime& dateTimeController,
   lv_label_set_text_static(labelBtnSettings, Symbols::settings);
   lv_obj_set_hidden(btnSettings, true);
 
-  taskRefresh = lv_task_create(RefreshTaskCallback, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, this);
+  taskRefresh = lv_task_create(RefreshTaskCallback, RefreshPeriods::Frame, LV_TASK_PRIO_MID, this);
   Refresh();
 }
 
@@ -317,6 +317,7 @@ bool WatchFaceInfineat::OnTouchEvent(Pinetime::Applications::TouchEvents event)
   if ((event == Pinetime::Applications::TouchEvents::LongTap) && lv_obj_get_hidden(btnSettings)) {
     lv_obj_set_hidden(btnSettings, false);
     savedTick = lv_tick_get();
+    lv_task_set_prio(taskRefresh, LV_TASK_PRIO_MID);
     return true;
   }
   // Prevent screen from sleeping when double tapping with settings on
@@ -464,6 +465,9 @@ void WatchFaceInfineat::Refresh() {
       savedTick = 0;
     }
   }
+
+  // Other changes are notified by DisplayApp: only poll while animating the battery or showing the settings button
+  lv_task_set_prio(taskRefresh, (isCharging.Get() || savedTick > 0) ? LV_TASK_PRIO_MID : LV_TASK_PRIO_OFF);
 }
 
 void WatchFaceInfineat::SetBatteryLevel(uint8_t batteryPercent) {
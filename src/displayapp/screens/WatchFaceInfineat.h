@@ -42,6 +42,14 @@ namespace Pinetime {
 
         void Refresh() override;
 
+        Controllers::ChangeEventMask RefreshEvents() const override {
+          return Controllers::ToMask(Controllers::ChangeEvents::Minute,
+                                     Controllers::ChangeEvents::Battery,
+                                     Controllers::ChangeEvents::Ble,
+                                     Controllers::ChangeEvents::Notification,
+                                     Controllers::ChangeEvents::Steps);
+        }
+
         static bool IsAvailable(Pinetime::Controllers::FS& filesystem);
 
       private:
@@ -23,6 +23,10 @@ namespace Pinetime {
     class MotionController;
   }
 
+  namespace Components {
+    class LittleVgl;
+  }
+
   namespace Applications {
     namespace Screens {
       class WatchFacePineTimeStyle : public Screen {
@@ -33,7 +37,8 @@ namespace Pinetime {
                                Controllers::NotificationManager& notificationManager,
                                Controllers::Settings& settingsController,
                                Controllers::MotionController& motionController,
-                               Controllers::SimpleWeatherService& weather);
+                               Controllers::SimpleWeatherService& weather,
+                               Components::LittleVgl& lvgl);
         ~WatchFacePineTimeStyle() override;
 
         bool OnTouchEvent(TouchEvents event) override;
@@ -41,6 +46,15 @@ namespace Pinetime {
 
         void Refresh() override;
 
+        Controllers::ChangeEventMask RefreshEvents() const override {
+          return Controllers::ToMask(Controllers::ChangeEvents::Second,
+                                     Controllers::ChangeEvents::Battery,
+                                     Controllers::ChangeEvents::Ble,
+                                     Controllers::ChangeEvents::Notification,
+                                     Controllers::ChangeEvents::Steps,
+                                     Controllers::ChangeEvents::Weather);
+        }
+
         void UpdateSelected(lv_obj_t* object, lv_event_t event);
 
       private:
@@ -113,11 +127,10 @@ namespace Pinetime {
         Controllers::Settings& settingsController;
         Controllers::MotionController& motionController;
         Controllers::SimpleWeatherService& weatherService;
+        Components::LittleVgl& lvgl;
 
         void SetBatteryIcon();
         void CloseMenu();
-
-        lv_task_t* taskRefresh;
       };
     }
 
@@ -133,7 +146,8 @@ namespace Pinetime {
                                                    controllers.notificationManager,
                                                    controllers.settingsController,
                                                    controllers.motionController,
-                                                   *controllers.weatherController);
+                                                   *controllers.weatherController,
+                                                   controllers.lvgl);
       };
 
       static bool IsAvailable(Pinetime::Controllers::FS& /*filesystem*/) {
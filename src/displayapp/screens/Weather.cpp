@@ -101,7 +101,7 @@ Weather::Weather(Controllers::Settings& settingsController, Controllers::SimpleW
     lv_table_set_cell_align(forecast, 3, i, LV_LABEL_ALIGN_CENTER);
   }
 
-  taskRefresh = lv_task_create(RefreshTaskCallback, 1000, LV_TASK_PRIO_MID, this);
+  taskRefresh = lv_task_create(RefreshTaskCallback, RefreshPeriods::Second, LV_TASK_PRIO_MID, this);
   Refresh();
 }
 
@@ -119,7 +119,7 @@ QuickSettings::QuickSettings(Pinetime::Applications::DisplayApp* app,
   lv_obj_set_style_local_text_font(lbl_btn, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, &lv_font_sys_48);
   lv_label_set_text_static(lbl_btn, Symbols::settings);
 
-  taskUpdate = lv_task_create(lv_update_task, 500, LV_TASK_PRIO_MID, this);
+  taskUpdate = lv_task_create(lv_update_task, RefreshPeriods::Second, LV_TASK_PRIO_MID, this);
 
   UpdateScreen();
 }
@@ -0,0 +1,62 @@
+#include "displayapp/screens/settings/SettingWakeUpDetection.h"
+#include <lvgl/lvgl.h>
+#include "displayapp/DisplayApp.h"
+#include "displayapp/screens/Styles.h"
+#include "displayapp/screens/Screen.h"
+#include "displayapp/screens/Symbols.h"
+#include <array>
+
+using namespace Pinetime::Applications::Screens;
+
+namespace {
+  struct Option {
+    Pinetime::Controllers::Settings::WakeUpDetection detection;
+    const char* name;
+  };
+
+  constexpr std::array<Option, 2> options = {{
+    {Pinetime::Controllers::Settings::WakeUpDetection::Software, "Watch"},
+    {Pinetime::Controllers::Settings::WakeUpDetection::Sensor, "Accelerometer"},
+  }};
+
+  std::array<CheckboxList::Item, CheckboxList::MaxItems> CreateOptionArray() {
+    std::array<Pinetime::Applications::Screens::CheckboxList::Item, CheckboxList::MaxItems> optionArray;
+    for (size_t i = 0; i < CheckboxList::MaxItems; i++) {
+      if (i >= options.size()) {
+        optionArray[i].name = "";
+        optionArray[i].enabled = false;
+      } else {
+        optionArray[i].name = options[i].name;
+        optionArray[i].enabled = true;
+      }
+    }
+    return optionArray;
+  }
+
+  uint32_t GetDefaultOption(Pinetime::Controllers::Settings::WakeUpDetection currentOption) {
+    for (size_t i = 0; i < options.size(); i++) {
+      if (options[i].detection == currentOption) {
+        return i;
+      }
+    }
+    return 0;
+  }
+}
+
+SettingWakeUpDetection::SettingWakeUpDetection(Pinetime::Controllers::Settings& settingsController)
+  : checkboxList(
+      0,
+      1,
+      "Wake Sensor",
+      Symbols::eye,
+      GetDefaultOption(settingsController.GetWakeUpDetection()),
+      [&settings = settingsController](uint32_t index) {
+        settings.SetWakeUpDetection(options[index].detection);
+        settings.SaveSettings();
+      },
+      CreateOptionArray()) {
+}
+
+SettingWakeUpDetection::~SettingWakeUpDetection() {
+  lv_obj_clean(lv_scr_act());
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+#include <lvgl/lvgl.h>
+
+#include "components/settings/Settings.h"
+#include "displayapp/screens/Screen.h"
+#include "displayapp/screens/CheckboxList.h"
+
+namespace Pinetime {
+
+  namespace Applications {
+    namespace Screens {
+
+      class SettingWakeUpDetection : public Screen {
+      public:
+        SettingWakeUpDetection(Pinetime::Controllers::Settings& settingsController);
+        ~SettingWakeUpDetection() override;
+
+      private:
+        CheckboxList checkboxList;
+      };
+    }
+  }
+}
@@ -50,7 +50,7 @@ namespace Pinetime {
           {Symbols::check, "Firmware", Apps::FirmwareValidation},
           {Symbols::bluetooth, "Bluetooth", Apps::SettingBluetooth},
           {Symbols::list, "About", Apps::SysInfo},
-          {Symbols::none, "None", Apps::None},
+          {Symbols::eye, "Wake Sensor", Apps::SettingWakeUpDetection},
 
           // {Symbols::none, "None", Apps::None},
 
@@ -1,4 +1,5 @@
 #include "drivers/Bma421.h"
+#include <algorithm>
 #include <libraries/delay/nrf_delay.h>
 #include <libraries/log/nrf_log.h>
 #include "drivers/TwiMaster.h"
@@ -32,6 +33,14 @@ namespace {
     [BMA4_ACCEL_RANGE_8G] = 256,  // LSB/g +/- 8g range
     [BMA4_ACCEL_RANGE_16G] = 128  // LSB/g +/- 16g range
   };
+
+  constexpr uint8_t fifoFlushCommand = 0xB0;
+
+  // Slope thresholds in 5.11g format (0.49mg/LSB) and durations in 50Hz samples
+  constexpr uint16_t anyMotionThreshold = 512; // 250mg, well above the noise of a wrist at rest
+  constexpr uint16_t anyMotionDuration = 5;    // 100ms
+  constexpr uint16_t noMotionThreshold = 170;  // 83mg
+  constexpr uint16_t noMotionDuration = 100;   // 2s
 }
 
 Bma421::Bma421(TwiMaster& twiMaster, uint8_t twiAddress) : twiMaster {twiMaster}, deviceAddress {twiAddress} {
@@ -92,7 +101,44 @@ void Bma421::Init() {
   if (ret != BMA4_OK)
     return;
 
+  // Buffer the acceleration samples in the FIFO (headerless, accelerometer only) so that the MCU is
+  // only woken up when a batch of samples is available instead of polling the data registers.
+  ret = bma4_set_fifo_config(BMA4_FIFO_ALL, 0, &bma);
+  if (ret != BMA4_OK)
+    return;
+
+  ret = bma4_set_fifo_config(BMA4_FIFO_ACCEL, 1, &bma);
+  if (ret != BMA4_OK)
+    return;
+
+  ret = bma4_set_accel_fifo_filter_data(1, &bma);
+  if (ret != BMA4_OK)
+    return;
+
+  ret = bma4_set_fifo_down_accel(fifoDownsampling, &bma);
+  if (ret != BMA4_OK)
+    return;
+
+  ret = bma4_set_fifo_wm(fifoWatermark * BMA4_ACCEL_DATA_LENGTH, &bma);
+  if (ret != BMA4_OK)
+    return;
+
+  struct bma4_int_pin_config pinConfig;
+  pinConfig.edge_ctrl = BMA4_LEVEL_TRIGGER;
+  pinConfig.lvl = BMA4_ACTIVE_HIGH;
+  pinConfig.od = BMA4_PUSH_PULL;
+  pinConfig.output_en = BMA4_OUTPUT_ENABLE;
+  pinConfig.input_en = BMA4_INPUT_DISABLE;
+  ret = bma4_set_int_pin_config(&pinConfig, BMA4_INTR1_MAP, &bma);
+  if (ret != BMA4_OK)
+    return;
+
+  SetInterrupts(true, false, false);
+  if (interruptMap != BMA4_FIFO_WM_INT)
+    return;
+
   isOk = true;
+  areGesturesOk = InitGestures();
 }
 
 void Bma421::Reset() {
@@ -108,31 +154,136 @@ void Bma421::Write(uint8_t registerAddress, const uint8_t* data, size_t size) {
   twiMaster.Write(deviceAddress, registerAddress, data, size);
 }
 
-Bma421::Values Bma421::Process() {
-  if (not isOk)
-    return {};
+size_t Bma421::Process(Values* values, size_t maxValues) {
+  if (not isOk || maxValues == 0)
+    return 0;
+
+  gestures = {};
+
+  uint8_t fifoLength[2];
+  uint8_t stepData[BMA423_STEP_CNTR_DATA_SIZE];
+  const TwiMaster::RegisterRead statusReads[] = {
+    {BMA4_FIFO_LENGTH_0_ADDR, fifoLength, sizeof(fifoLength)},
+    {BMA4_STEP_CNT_OUT_0_ADDR, stepData, sizeof(stepData)},
+  };
+  if (twiMaster.Read(deviceAddress, statusReads, sizeof(statusReads) / sizeof(statusReads[0])) != TwiMaster::ErrorCodes::NoError)
+    return 0;
+
+  uint32_t steps = stepData[0] | (stepData[1] << 8) | (stepData[2] << 16) | (static_cast<uint32_t>(stepData[3]) << 24);
+  size_t nbBytes = ((fifoLength[1] & BMA4_FIFO_BYTE_COUNTER_MSB_MSK) << 8) | fifoLength[0];
+  size_t nbSamples = nbBytes / BMA4_ACCEL_DATA_LENGTH;
+  maxValues = std::min(maxValues, maxFifoSamples);
+
+  // Reading the interrupt status clears the latched interrupts, so it must be read after the FIFO
+  uint8_t interruptStatus[2];
+  TwiMaster::RegisterRead dataReads[] = {
+    {BMA4_FIFO_DATA_ADDR, fifoData, nbSamples * BMA4_ACCEL_DATA_LENGTH},
+    {BMA4_INT_STAT_0_ADDR, interruptStatus, sizeof(interruptStatus)},
+  };
+  if (nbSamples == 0 || nbSamples > maxValues) {
+    if (nbSamples > 0) {
+      uint8_t command = fifoFlushCommand;
+      Write(BMA4_CMD_ADDR, &command, 1);
+    }
+    nbSamples = 1;
+    dataReads[0] = {BMA4_DATA_8_ADDR, fifoData, BMA4_ACCEL_DATA_LENGTH};
+  }
+  if (twiMaster.Read(deviceAddress, dataReads, sizeof(dataReads) / sizeof(dataReads[0])) != TwiMaster::ErrorCodes::NoError)
+    return 0;
+
+  if (areGesturesOk) {
+    gestures.wristTilt = (interruptStatus[0] & BMA423_WRIST_WEAR_INT) != 0;
+    gestures.anyMotion = (interruptStatus[0] & BMA423_ANY_MOT_INT) != 0;
+    gestures.noMotion = (interruptStatus[0] & BMA423_NO_MOT_INT) != 0;
+  }
+
+  for (size_t i = 0; i < nbSamples; i++) {
+    values[i] = ToValues(fifoData + i * BMA4_ACCEL_DATA_LENGTH, steps);
+  }
+  return nbSamples;
+}
+
+Bma421::Gestures Bma421::GetGestures() const {
+  return gestures;
+}
+
+void Bma421::SetInterrupts(bool fifoWatermark, bool wristTilt, bool motion) {
+  uint16_t map = 0;
+  if (fifoWatermark) {
+    map |= BMA4_FIFO_WM_INT;
+  }
+  if (areGesturesOk && wristTilt) {
+    map |= BMA423_WRIST_WEAR_INT;
+  }
+  if (areGesturesOk && motion) {
+    map |= BMA423_ANY_MOT_INT | BMA423_NO_MOT_INT;
+  }
+  if (map == interruptMap) {
+    return;
+  }
+
+  auto unmapped = static_cast<uint16_t>(interruptMap & ~map);
+  auto mapped = static_cast<uint16_t>(map & ~interruptMap);
+  if (unmapped != 0 && bma423_map_interrupt(BMA4_INTR1_MAP, unmapped, 0, &bma) != BMA4_OK) {
+    return;
+  }
+  interruptMap &= ~unmapped;
+  if (mapped != 0 && bma423_map_interrupt(BMA4_INTR1_MAP, mapped, 1, &bma) != BMA4_OK) {
+    return;
+  }
+  interruptMap |= mapped;
+}
+
+bool Bma421::AreGesturesAvailable() const {
+  return areGesturesOk;
+}
+
+bool Bma421::InitGestures() {
+  // The feature engine keeps running while the interrupts are not mapped, SetInterrupts() only selects
+  // which of its gestures wake up the MCU.
+  if (bma423_feature_enable(BMA423_WRIST_WEAR, 1, &bma) != BMA4_OK)
+    return false;
+
+  struct bma423_any_no_mot_config motionConfig;
+  motionConfig.threshold = anyMotionThreshold;
+  motionConfig.duration = anyMotionDuration;
+  motionConfig.axes_en = BMA423_EN_ALL_AXIS;
+  if (bma423_set_any_mot_config(&motionConfig, &bma) != BMA4_OK)
+    return false;
+
+  motionConfig.threshold = noMotionThreshold;
+  motionConfig.duration = noMotionDuration;
+  if (bma423_set_no_mot_config(&motionConfig, &bma) != BMA4_OK)
+    return false;
+
+  return true;
+}
+
+Bma421::Values Bma421::ToValues(const uint8_t* accelData, uint32_t steps) const {
   struct bma4_accel rawData;
-  struct bma4_accel data;
-  bma4_read_accel_xyz(&rawData, &bma);
+  rawData.x = static_cast<int16_t>((accelData[1] << 8) | accelData[0]);
+  rawData.y = static_cast<int16_t>((accelData[3] << 8) | accelData[2]);
+  rawData.z = static_cast<int16_t>((accelData[5] << 8) | accelData[4]);
+  // The data registers are left-aligned, see bma4_read_accel_xyz()
+  if (bma.resolution == BMA4_12_BIT_RESOLUTION) {
+    rawData.x /= 0x10;
+    rawData.y /= 0x10;
+    rawData.z /= 0x10;
+  } else if (bma.resolution == BMA4_14_BIT_RESOLUTION) {
+    rawData.x /= 0x04;
+    rawData.y /= 0x04;
+    rawData.z /= 0x04;
+  }
 
   // Scale the measured ADC counts to units of 'binary milli-g'
   // where 1g = 1024 'binary milli-g' units.
   // See https://github.com/InfiniTimeOrg/InfiniTime/pull/1950 for
   // discussion of why we opted for scaling to 1024 rather than 1000.
+  struct bma4_accel data;
   data.x = 1024 * rawData.x / accelScaleFactors[accel_conf.range];
   data.y = 1024 * rawData.y / accelScaleFactors[accel_conf.range];
   data.z = 1024 * rawData.z / accelScaleFactors[accel_conf.range];
 
-  uint32_t steps = 0;
-  bma423_step_counter_output(&steps, &bma);
-
-  int32_t temperature;
-  bma4_get_temperature(&temperature, BMA4_DEG, &bma);
-  temperature = temperature / 1000;
-
-  uint8_t activity = 0;
-  bma423_activity_output(&activity, &bma);
-
   // X and Y axis are swapped because of the way the sensor is mounted in the PineTime
   return {steps, data.y, data.x, data.z};
 }
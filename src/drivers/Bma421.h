@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 #include <drivers/Bma421_C/bma4_defs.h>
 
 namespace Pinetime {
@@ -16,6 +17,20 @@ namespace Pinetime {
         int16_t z;
       };
 
+      // Gestures detected by the feature engine of the sensor
+      struct Gestures {
+        bool wristTilt;
+        bool anyMotion;
+        bool noMotion;
+      };
+
+      // Samples are buffered in the FIFO at 100Hz / 2^fifoDownsampling
+      static constexpr uint8_t fifoDownsampling = 3;
+      static constexpr uint32_t fifoSamplePeriodMs = (1000 << fifoDownsampling) / 100;
+      // The interrupt pin is raised once this number of samples is buffered in the FIFO
+      static constexpr size_t fifoWatermark = 8;
+      static constexpr size_t maxFifoSamples = 2 * fifoWatermark;
+
       Bma421(TwiMaster& twiMaster, uint8_t twiAddress);
       Bma421(const Bma421&) = delete;
       Bma421& operator=(const Bma421&) = delete;
@@ -26,7 +41,15 @@ namespace Pinetime {
       /// Init() method to allow the caller to uninit and then reinit the TWI device after the softreset.
       void SoftReset();
       void Init();
-      Values Process();
+      /// Drains the FIFO into values (oldest sample first) and returns the number of samples read.
+      /// If the FIFO holds more samples than fit in values, they are too old to be of any use: the FIFO is
+      /// flushed and only the current acceleration is returned.
+      size_t Process(Values* values, size_t maxValues);
+      /// Gestures flagged by the sensor since the previous call to Process()
+      Gestures GetGestures() const;
+      /// Selects the events that raise the interrupt pin. Gesture interrupts are ignored if AreGesturesAvailable() is false.
+      void SetInterrupts(bool fifoWatermark, bool wristTilt, bool motion);
+      bool AreGesturesAvailable() const;
       void ResetStepCounter();
 
       void Read(uint8_t registerAddress, uint8_t* buffer, size_t size);
@@ -37,6 +60,8 @@ namespace Pinetime {
 
     private:
       void Reset();
+      Values ToValues(const uint8_t* accelData, uint32_t steps) const;
+      bool InitGestures();
 
       TwiMaster& twiMaster;
       uint8_t deviceAddress = 0x18;
@@ -44,7 +69,11 @@ namespace Pinetime {
       struct bma4_accel_config accel_conf; // Store the device configuration for later reference.
       bool isOk = false;
       bool isResetOk = false;
+      bool areGesturesOk = false;
+      uint16_t interruptMap = 0;
+      Gestures gestures = {};
       DeviceTypes deviceType = DeviceTypes::Unknown;
+      uint8_t fifoData[maxFifoSamples * BMA4_ACCEL_DATA_LENGTH];
     };
   }
 }
\ No newline at end of file
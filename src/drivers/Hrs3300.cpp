@@ -68,17 +68,36 @@ void Hrs3300::Disable() {
 }
 
 uint32_t Hrs3300::ReadHrs() {
-  auto m = ReadRegister(static_cast<uint8_t>(Registers::C0DataM));
-  auto h = ReadRegister(static_cast<uint8_t>(Registers::C0DataH));
-  auto l = ReadRegister(static_cast<uint8_t>(Registers::C0dataL));
-  return ((l & 0x30) << 12) | (m << 8) | ((h & 0x0f) << 4) | (l & 0x0f);
+  return ReadSamples().hrs;
 }
 
 uint32_t Hrs3300::ReadAls() {
-  auto m = ReadRegister(static_cast<uint8_t>(Registers::C1dataM));
-  auto h = ReadRegister(static_cast<uint8_t>(Registers::C1dataH));
-  auto l = ReadRegister(static_cast<uint8_t>(Registers::C1dataL));
-  return ((h & 0x3f) << 11) | (m << 3) | (l & 0x07);
+  return ReadSamples().als;
+}
+
+Hrs3300::Samples Hrs3300::ReadSamples() {
+  uint8_t hrsM = 0;
+  uint8_t hrsH = 0;
+  uint8_t hrsL = 0;
+  uint8_t alsM = 0;
+  uint8_t alsH = 0;
+  uint8_t alsL = 0;
+  // The data registers of both channels are read in a single bus session, so that HRS and ALS
+  // values come from the same conversion period.
+  const TwiMaster::RegisterRead reads[] = {
+    {static_cast<uint8_t>(Registers::C0DataM), &hrsM, 1},
+    {static_cast<uint8_t>(Registers::C0DataH), &hrsH, 1},
+    {static_cast<uint8_t>(Registers::C0dataL), &hrsL, 1},
+    {static_cast<uint8_t>(Registers::C1dataM), &alsM, 1},
+    {static_cast<uint8_t>(Registers::C1dataH), &alsH, 1},
+    {static_cast<uint8_t>(Registers::C1dataL), &alsL, 1},
+  };
+  twiMaster.Read(twiAddress, reads, sizeof(reads) / sizeof(reads[0]));
+
+  Samples samples;
+  samples.hrs = ((hrsL & 0x30) << 12) | (hrsM << 8) | ((hrsH & 0x0f) << 4) | (hrsL & 0x0f);
+  samples.als = ((alsH & 0x3f) << 11) | (alsM << 3) | (alsL & 0x07);
+  return samples;
 }
 
 void Hrs3300::SetGain(uint8_t gain) {
@@ -103,6 +122,16 @@ void Hrs3300::SetDrive(uint8_t drive) {
   WriteRegister(static_cast<uint8_t>(Registers::PDriver), pd);
 }
 
+void Hrs3300::SetWaitTime(WaitTime waitTime) {
+  auto en = ReadRegister(static_cast<uint8_t>(Registers::Enable));
+  en = (en & 0x8f) | (static_cast<uint8_t>(waitTime) << 4);
+  WriteRegister(static_cast<uint8_t>(Registers::Enable), en);
+}
+
+void Hrs3300::SetResolution(Resolution resolution) {
+  WriteRegister(static_cast<uint8_t>(Registers::Res), static_cast<uint8_t>(resolution));
+}
+
 void Hrs3300::WriteRegister(uint8_t reg, uint8_t data) {
   auto ret = twiMaster.Write(twiAddress, reg, &data, 1);
   if (ret != TwiMaster::ErrorCodes::NoError)
@@ -6,6 +6,11 @@ namespace Pinetime {
   namespace Drivers {
     class Hrs3300 {
     public:
+      struct Samples {
+        uint32_t hrs;
+        uint32_t als;
+      };
+
       enum class Registers : uint8_t {
         Id = 0x00,
         Enable = 0x01,
@@ -32,8 +37,18 @@ namespace Pinetime {
       void Disable();
       uint32_t ReadHrs();
       uint32_t ReadAls();
+      // Reads both the HRS and the ALS channels at once
+      Samples ReadSamples();
+      // Time between the end of a conversion and the start of the next one
+      enum class WaitTime : uint8_t { Ms800, Ms400, Ms200, Ms100, Ms75, Ms50, Ms12_5, Ms0 };
+      // Resolution of both the HRS and ALS conversions. The LED is on during the whole conversion,
+      // which takes ~50ms at 15 bits and halves with each bit removed.
+      enum class Resolution : uint8_t { Bits14 = 0x66, Bits15 = 0x77 };
+
       void SetGain(uint8_t gain);
       void SetDrive(uint8_t drive);
+      void SetWaitTime(WaitTime waitTime);
+      void SetResolution(Resolution resolution);
 
     private:
       TwiMaster& twiMaster;
@@ -4,13 +4,18 @@
 
 using namespace Pinetime::Drivers;
 
-Spi::Spi(SpiMaster& spiMaster, uint8_t pinCsn) : spiMaster {spiMaster}, pinCsn {pinCsn} {
+Spi::Spi(SpiMaster& spiMaster, uint8_t pinCsn, SpiMaster::Priority priority)
+  : spiMaster {spiMaster}, pinCsn {pinCsn}, priority {priority} {
   nrf_gpio_cfg_output(pinCsn);
   nrf_gpio_pin_set(pinCsn);
 }
 
 bool Spi::Write(const uint8_t* data, size_t size) {
-  return spiMaster.Write(pinCsn, data, size);
+  return spiMaster.Write(pinCsn, data, size, priority);
+}
+
+bool Spi::WriteRepeated(const uint8_t* data, size_t size, size_t nbRepeats) {
+  return spiMaster.WriteRepeated(pinCsn, data, size, nbRepeats, priority);
 }
 
 bool Spi::Read(uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize) {
@@ -26,6 +31,20 @@ bool Spi::WriteCmdAndBuffer(const uint8_t* cmd, size_t cmdSize, const uint8_t* d
   return spiMaster.WriteCmdAndBuffer(pinCsn, cmd, cmdSize, data, dataSize);
 }
 
+bool Spi::ReadAsync(
+  const uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize, SpiMaster::TransferDoneCallback callback, void* context) {
+  return spiMaster.ReadAsync(pinCsn, cmd, cmdSize, data, dataSize, priority, callback, context);
+}
+
+bool Spi::WriteCmdAndBufferAsync(
+  const uint8_t* cmd, size_t cmdSize, const uint8_t* data, size_t dataSize, SpiMaster::TransferDoneCallback callback, void* context) {
+  return spiMaster.WriteCmdAndBufferAsync(pinCsn, cmd, cmdSize, data, dataSize, priority, callback, context);
+}
+
+bool Spi::WriteCommands(uint8_t pinDataCommand, const SpiMaster::Command* commands, size_t nbCommands) {
+  return spiMaster.WriteCommands(pinCsn, pinDataCommand, commands, nbCommands);
+}
+
 bool Spi::Init() {
   nrf_gpio_cfg_output(pinCsn);
   nrf_gpio_pin_set(pinCsn);
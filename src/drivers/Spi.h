@@ -7,7 +7,8 @@ namespace Pinetime {
   namespace Drivers {
     class Spi {
     public:
-      Spi(SpiMaster& spiMaster, uint8_t pinCsn);
+      // Queued transfers of the device are arbitrated with the given priority (see SpiMaster)
+      Spi(SpiMaster& spiMaster, uint8_t pinCsn, SpiMaster::Priority priority = SpiMaster::Priority::Low);
       Spi(const Spi&) = delete;
       Spi& operator=(const Spi&) = delete;
       Spi(Spi&&) = delete;
@@ -15,14 +16,29 @@ namespace Pinetime {
 
       bool Init();
       bool Write(const uint8_t* data, size_t size);
+      bool WriteRepeated(const uint8_t* data, size_t size, size_t nbRepeats);
       bool Read(uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize);
       bool WriteCmdAndBuffer(const uint8_t* cmd, size_t cmdSize, const uint8_t* data, size_t dataSize);
+      bool ReadAsync(const uint8_t* cmd,
+                     size_t cmdSize,
+                     uint8_t* data,
+                     size_t dataSize,
+                     SpiMaster::TransferDoneCallback callback,
+                     void* context);
+      bool WriteCmdAndBufferAsync(const uint8_t* cmd,
+                                  size_t cmdSize,
+                                  const uint8_t* data,
+                                  size_t dataSize,
+                                  SpiMaster::TransferDoneCallback callback,
+                                  void* context);
+      bool WriteCommands(uint8_t pinDataCommand, const SpiMaster::Command* commands, size_t nbCommands);
       void Sleep();
       void Wakeup();
 
     private:
       SpiMaster& spiMaster;
       uint8_t pinCsn;
+      SpiMaster::Priority priority;
     };
   }
 }
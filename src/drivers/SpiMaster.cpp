@@ -90,6 +90,10 @@ bool SpiMaster::Init() {
   NRFX_IRQ_PRIORITY_SET(SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQn, 2);
   NRFX_IRQ_ENABLE(SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQn);
 
+  // TIMER2 counts the chunks of streamed transfers and raises an interrupt when the last one is sent
+  NRFX_IRQ_PRIORITY_SET(TIMER2_IRQn, 2);
+  NRFX_IRQ_ENABLE(TIMER2_IRQn);
+
   xSemaphoreGive(mutex);
   return true;
 }
@@ -122,35 +126,219 @@ void SpiMaster::DisableWorkaroundForFtpan58(NRF_SPIM_Type* spim, uint32_t ppi_ch
   spim->INTENSET = (1 << 19);
 }
 
+void SpiMaster::SetupStream(size_t nbChunks, bool repeatChunk) {
+  NRF_TIMER2->TASKS_STOP = 1;
+  NRF_TIMER2->MODE = TIMER_MODE_MODE_LowPowerCounter << TIMER_MODE_MODE_Pos;
+  NRF_TIMER2->BITMODE = TIMER_BITMODE_BITMODE_16Bit << TIMER_BITMODE_BITMODE_Pos;
+  NRF_TIMER2->TASKS_CLEAR = 1;
+  NRF_TIMER2->CC[0] = nbChunks - 1;
+  NRF_TIMER2->CC[1] = nbChunks;
+  NRF_TIMER2->EVENTS_COMPARE[0] = 0;
+  NRF_TIMER2->EVENTS_COMPARE[1] = 0;
+  NRF_TIMER2->SHORTS = TIMER_SHORTS_COMPARE1_STOP_Msk;
+  NRF_TIMER2->INTENSET = TIMER_INTENSET_COMPARE1_Msk;
+  NRF_TIMER2->TASKS_START = 1;
+
+  // Restart the transfer on the next chunk of the list each time a chunk is sent.
+  NRF_PPI->CH[streamRestartPpiChannel].EEP = (uint32_t) &spiBaseAddress->EVENTS_END;
+  NRF_PPI->CH[streamRestartPpiChannel].TEP = (uint32_t) &spiBaseAddress->TASKS_START;
+  NRF_PPI->CHG[streamPpiGroup] = 1U << streamRestartPpiChannel;
+
+  // Count the chunks that have been sent.
+  NRF_PPI->CH[streamCountPpiChannel].EEP = (uint32_t) &spiBaseAddress->EVENTS_END;
+  NRF_PPI->CH[streamCountPpiChannel].TEP = (uint32_t) &NRF_TIMER2->TASKS_COUNT;
+
+  // Once the last chunk is started, stop restarting the transfer.
+  NRF_PPI->CH[streamStopPpiChannel].EEP = (uint32_t) &NRF_TIMER2->EVENTS_COMPARE[0];
+  NRF_PPI->CH[streamStopPpiChannel].TEP = (uint32_t) &NRF_PPI->TASKS_CHG[streamPpiGroup].DIS;
+
+  NRF_PPI->CHENSET = (1U << streamCountPpiChannel) | (1U << streamStopPpiChannel);
+  NRF_PPI->TASKS_CHG[streamPpiGroup].EN = 1;
+
+  // The end of the stream is signaled by TIMER2, the chunks restarted by PPI must not interrupt the CPU
+  spiBaseAddress->INTENCLR = (1 << 6);
+  spiBaseAddress->INTENCLR = (1 << 1);
+  spiBaseAddress->INTENCLR = (1 << 19);
+  // In ArrayList mode, TXD.PTR moves to the next chunk after each transfer, otherwise the same chunk is sent again
+  if (!repeatChunk) {
+    spiBaseAddress->TXD.LIST = SPIM_TXD_LIST_LIST_ArrayList << SPIM_TXD_LIST_LIST_Pos;
+  }
+  streaming = true;
+}
+
+void SpiMaster::DisableStream() {
+  NRF_PPI->TASKS_CHG[streamPpiGroup].DIS = 1;
+  NRF_PPI->CHENCLR = (1U << streamRestartPpiChannel) | (1U << streamCountPpiChannel) | (1U << streamStopPpiChannel);
+  NRF_PPI->CHG[streamPpiGroup] = 0;
+
+  NRF_TIMER2->TASKS_STOP = 1;
+  NRF_TIMER2->INTENCLR = TIMER_INTENCLR_COMPARE1_Msk;
+  NRF_TIMER2->SHORTS = 0;
+  NRF_TIMER2->EVENTS_COMPARE[0] = 0;
+  NRF_TIMER2->EVENTS_COMPARE[1] = 0;
+
+  spiBaseAddress->TXD.LIST = 0;
+  spiBaseAddress->EVENTS_END = 0;
+  spiBaseAddress->EVENTS_STARTED = 0;
+  spiBaseAddress->EVENTS_STOPPED = 0;
+  spiBaseAddress->INTENSET = (1 << 6);
+  spiBaseAddress->INTENSET = (1 << 1);
+  spiBaseAddress->INTENSET = (1 << 19);
+  streaming = false;
+}
+
+void SpiMaster::OnStreamEndEvent() {
+  if (!streaming) {
+    return;
+  }
+
+  DisableStream();
+  // Send the remaining chunks (if any) and release the bus
+  OnEndEvent();
+}
+
 void SpiMaster::OnEndEvent() {
-  if (currentBufferAddr == 0) {
+  if (!transactionRunning) {
+    return;
+  }
+
+  const auto& transaction = currentTransaction;
+  if (transaction.cmdSize > 0 || transaction.dataSize > 0 || transaction.nbRepeats > 0) {
+    if (transaction.priority == Priority::Low && !transactionSuspended && HasQueuedTransaction(Priority::High)) {
+      // The display accepts pauses between two chunks of pixels, as long as no command is sent meanwhile
+      nrf_gpio_pin_set(transaction.pinCsn);
+      suspendedTransaction = transaction;
+      transactionSuspended = true;
+      StartNextTransaction();
+    } else {
+      ContinueTransaction();
+    }
     return;
   }
 
-  auto s = currentBufferSize;
-  if (s > 0) {
-    auto currentSize = std::min((size_t) 255, s);
-    PrepareTx(currentBufferAddr, currentSize);
-    currentBufferAddr = currentBufferAddr + currentSize;
-    currentBufferSize = currentBufferSize - currentSize;
+  nrf_gpio_pin_set(transaction.pinCsn);
+  transactionRunning = false;
 
-    spiBaseAddress->TASKS_START = 1;
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+  if (transaction.taskToNotify != nullptr) {
+    vTaskNotifyGiveFromISR(transaction.taskToNotify, &xHigherPriorityTaskWoken);
+  }
+  BaseType_t xHigherPriorityTaskWoken2 = pdFALSE;
+  if (transaction.callback != nullptr) {
+    transaction.callback(transaction.context, &xHigherPriorityTaskWoken2);
+  }
+
+  BaseType_t xHigherPriorityTaskWoken3 = pdFALSE;
+  if (!StartNextTransaction()) {
+    xSemaphoreGiveFromISR(mutex, &xHigherPriorityTaskWoken3);
+  }
+  portYIELD_FROM_ISR(xHigherPriorityTaskWoken | xHigherPriorityTaskWoken2 | xHigherPriorityTaskWoken3);
+}
+
+void SpiMaster::OnStartedEvent() {
+}
+
+bool SpiMaster::HasQueuedTransaction(Priority priority) const {
+  for (size_t i = 0; i < nbQueuedTransactions; i++) {
+    if (queue[i].priority == priority) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool SpiMaster::StartNextTransaction() {
+  // The oldest of the queued transactions with the highest priority
+  size_t next = nbQueuedTransactions;
+  for (size_t i = 0; i < nbQueuedTransactions; i++) {
+    if (next == nbQueuedTransactions || queue[i].priority > queue[next].priority) {
+      next = i;
+    }
+  }
+
+  if (transactionSuspended && (next == nbQueuedTransactions || queue[next].priority <= suspendedTransaction.priority)) {
+    currentTransaction = suspendedTransaction;
+    transactionSuspended = false;
+  } else if (next < nbQueuedTransactions) {
+    currentTransaction = queue[next];
+    std::copy(queue + next + 1, queue + nbQueuedTransactions, queue + next);
+    nbQueuedTransactions--;
   } else {
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-    if (taskToNotify != nullptr) {
-      vTaskNotifyGiveFromISR(taskToNotify, &xHigherPriorityTaskWoken);
-      portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+    return false;
+  }
+
+  transactionRunning = true;
+  DisableWorkaroundForFtpan58(spiBaseAddress, 0, 0);
+  nrf_gpio_pin_clear(currentTransaction.pinCsn);
+  ContinueTransaction();
+  return true;
+}
+
+void SpiMaster::ContinueTransaction() {
+  auto& transaction = currentTransaction;
+  const size_t maxChunks = (transaction.priority == Priority::Low) ? maxPreemptibleStreamChunks : maxStreamChunks;
+
+  if (transaction.cmdSize > 0) {
+    PrepareTx((uint32_t) transaction.cmd, transaction.cmdSize);
+    transaction.cmdSize = 0;
+  } else if (transaction.nbRepeats > 0) {
+    const size_t nbChunks = std::min(transaction.nbRepeats, maxChunks);
+    PrepareTx(transaction.dataAddress, transaction.dataSize);
+    if (nbChunks > 1) {
+      SetupStream(nbChunks, true);
+    }
+    transaction.nbRepeats -= nbChunks;
+    if (transaction.nbRepeats == 0) {
+      transaction.dataSize = 0;
+    }
+  } else {
+    const size_t nbChunks = std::min(transaction.dataSize / maxChunkSize, maxChunks);
+    if (!transaction.receiving && nbChunks > 1) {
+      // Chain the full chunks in hardware: the CPU is only interrupted once they are all sent
+      PrepareTx(transaction.dataAddress, maxChunkSize);
+      SetupStream(nbChunks, false);
+      transaction.dataAddress += nbChunks * maxChunkSize;
+      transaction.dataSize -= nbChunks * maxChunkSize;
+    } else {
+      auto currentSize = std::min(maxChunkSize, transaction.dataSize);
+      if (transaction.dataSize - currentSize == 1) {
+        // Don't leave a single byte for the last chunk (FTPAN-58)
+        currentSize--;
+      }
+      if (transaction.receiving) {
+        PrepareRx(transaction.dataAddress, currentSize);
+      } else {
+        PrepareTx(transaction.dataAddress, currentSize);
+      }
+      transaction.dataAddress += currentSize;
+      transaction.dataSize -= currentSize;
     }
+  }
+  spiBaseAddress->TASKS_START = 1;
+}
 
-    nrf_gpio_pin_set(this->pinCsn);
-    currentBufferAddr = 0;
-    BaseType_t xHigherPriorityTaskWoken2 = pdFALSE;
-    xSemaphoreGiveFromISR(mutex, &xHigherPriorityTaskWoken2);
-    portYIELD_FROM_ISR(xHigherPriorityTaskWoken | xHigherPriorityTaskWoken2);
+bool SpiMaster::Submit(const Transaction& transaction) {
+  taskENTER_CRITICAL();
+  if (nbQueuedTransactions == maxQueuedTransactions) {
+    taskEXIT_CRITICAL();
+    return false;
+  }
+  queue[nbQueuedTransactions++] = transaction;
+  taskEXIT_CRITICAL();
+
+  // Start the transaction now if the bus is free, otherwise the current owner of the bus will start it
+  if (xSemaphoreTake(mutex, 0) == pdTRUE) {
+    ReleaseBus();
   }
+  return true;
 }
 
-void SpiMaster::OnStartedEvent() {
+void SpiMaster::ReleaseBus() {
+  taskENTER_CRITICAL();
+  if (!StartNextTransaction()) {
+    xSemaphoreGive(mutex);
+  }
+  taskEXIT_CRITICAL();
 }
 
 void SpiMaster::PrepareTx(const uint32_t bufferAddress, const size_t size) {
@@ -173,12 +361,26 @@ void SpiMaster::PrepareRx(const uint32_t bufferAddress, const size_t size) {
   spiBaseAddress->EVENTS_END = 0;
 }
 
-bool SpiMaster::Write(uint8_t pinCsn, const uint8_t* data, size_t size) {
+bool SpiMaster::Write(uint8_t pinCsn, const uint8_t* data, size_t size, Priority priority) {
   if (data == nullptr)
     return false;
+
+  if (size > maxPolledWriteSize) {
+    return Submit({.pinCsn = pinCsn,
+                   .priority = priority,
+                   .cmd = nullptr,
+                   .cmdSize = 0,
+                   .dataAddress = (uint32_t) data,
+                   .dataSize = size,
+                   .nbRepeats = 0,
+                   .receiving = false,
+                   .taskToNotify = xTaskGetCurrentTaskHandle(),
+                   .callback = nullptr,
+                   .context = nullptr});
+  }
+
   auto ok = xSemaphoreTake(mutex, portMAX_DELAY);
   ASSERT(ok == true);
-  taskToNotify = xTaskGetCurrentTaskHandle();
 
   this->pinCsn = pinCsn;
 
@@ -186,38 +388,54 @@ bool SpiMaster::Write(uint8_t pinCsn, const uint8_t* data, size_t size) {
     SetupWorkaroundForFtpan58(spiBaseAddress, 0, 0);
   } else {
     DisableWorkaroundForFtpan58(spiBaseAddress, 0, 0);
+    spiBaseAddress->INTENCLR = (1 << 6);
+    spiBaseAddress->INTENCLR = (1 << 1);
+    spiBaseAddress->INTENCLR = (1 << 19);
   }
 
   nrf_gpio_pin_clear(this->pinCsn);
 
-  currentBufferAddr = (uint32_t) data;
-  currentBufferSize = size;
-
-  auto currentSize = std::min((size_t) 255, (size_t) currentBufferSize);
-  PrepareTx(currentBufferAddr, currentSize);
-  currentBufferSize = currentBufferSize - currentSize;
-  currentBufferAddr = currentBufferAddr + currentSize;
+  PrepareTx((uint32_t) data, size);
   spiBaseAddress->TASKS_START = 1;
+  while (spiBaseAddress->EVENTS_END == 0)
+    ;
+  nrf_gpio_pin_set(this->pinCsn);
 
-  if (size == 1) {
-    while (spiBaseAddress->EVENTS_END == 0)
-      ;
-    nrf_gpio_pin_set(this->pinCsn);
-    currentBufferAddr = 0;
-
-    DisableWorkaroundForFtpan58(spiBaseAddress, 0, 0);
+  DisableWorkaroundForFtpan58(spiBaseAddress, 0, 0);
 
-    xSemaphoreGive(mutex);
+  // Notify the caller like the END interrupt does, the display waits for it before each flush
+  if (size > 1) {
+    xTaskNotifyGive(xTaskGetCurrentTaskHandle());
   }
 
+  ReleaseBus();
+
   return true;
 }
 
+bool SpiMaster::WriteRepeated(uint8_t pinCsn, const uint8_t* data, size_t size, size_t nbRepeats, Priority priority) {
+  if (data == nullptr || size == 0 || size > maxChunkSize || nbRepeats == 0 || nbRepeats > maxStreamChunks)
+    return false;
+  if (nbRepeats == 1) {
+    return Write(pinCsn, data, size, priority);
+  }
+
+  return Submit({.pinCsn = pinCsn,
+                 .priority = priority,
+                 .cmd = nullptr,
+                 .cmdSize = 0,
+                 .dataAddress = (uint32_t) data,
+                 .dataSize = size,
+                 .nbRepeats = nbRepeats,
+                 .receiving = false,
+                 .taskToNotify = xTaskGetCurrentTaskHandle(),
+                 .callback = nullptr,
+                 .context = nullptr});
+}
+
 bool SpiMaster::Read(uint8_t pinCsn, uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize) {
   xSemaphoreTake(mutex, portMAX_DELAY);
 
-  taskToNotify = nullptr;
-
   this->pinCsn = pinCsn;
   DisableWorkaroundForFtpan58(spiBaseAddress, 0, 0);
   spiBaseAddress->INTENCLR = (1 << 6);
@@ -226,9 +444,6 @@ bool SpiMaster::Read(uint8_t pinCsn, uint8_t* cmd, size_t cmdSize, uint8_t* data
 
   nrf_gpio_pin_clear(this->pinCsn);
 
-  currentBufferAddr = 0;
-  currentBufferSize = 0;
-
   PrepareTx((uint32_t) cmd, cmdSize);
   spiBaseAddress->TASKS_START = 1;
   while (spiBaseAddress->EVENTS_END == 0)
@@ -241,12 +456,15 @@ bool SpiMaster::Read(uint8_t pinCsn, uint8_t* cmd, size_t cmdSize, uint8_t* data
     ;
   nrf_gpio_pin_set(this->pinCsn);
 
-  xSemaphoreGive(mutex);
+  ReleaseBus();
 
   return true;
 }
 
 void SpiMaster::Sleep() {
+  if (streaming) {
+    DisableStream();
+  }
   while (spiBaseAddress->ENABLE != 0) {
     spiBaseAddress->ENABLE = (SPIM_ENABLE_ENABLE_Disabled << SPIM_ENABLE_ENABLE_Pos);
   }
@@ -265,8 +483,6 @@ void SpiMaster::Wakeup() {
 bool SpiMaster::WriteCmdAndBuffer(uint8_t pinCsn, const uint8_t* cmd, size_t cmdSize, const uint8_t* data, size_t dataSize) {
   xSemaphoreTake(mutex, portMAX_DELAY);
 
-  taskToNotify = nullptr;
-
   this->pinCsn = pinCsn;
   DisableWorkaroundForFtpan58(spiBaseAddress, 0, 0);
   spiBaseAddress->INTENCLR = (1 << 6);
@@ -275,9 +491,6 @@ bool SpiMaster::WriteCmdAndBuffer(uint8_t pinCsn, const uint8_t* cmd, size_t cmd
 
   nrf_gpio_pin_clear(this->pinCsn);
 
-  currentBufferAddr = 0;
-  currentBufferSize = 0;
-
   PrepareTx((uint32_t) cmd, cmdSize);
   spiBaseAddress->TASKS_START = 1;
   while (spiBaseAddress->EVENTS_END == 0)
@@ -290,7 +503,94 @@ bool SpiMaster::WriteCmdAndBuffer(uint8_t pinCsn, const uint8_t* cmd, size_t cmd
     ;
   nrf_gpio_pin_set(this->pinCsn);
 
-  xSemaphoreGive(mutex);
+  ReleaseBus();
+
+  return true;
+}
+
+bool SpiMaster::ReadAsync(uint8_t pinCsn,
+                          const uint8_t* cmd,
+                          size_t cmdSize,
+                          uint8_t* data,
+                          size_t dataSize,
+                          Priority priority,
+                          TransferDoneCallback callback,
+                          void* context) {
+  if (cmd == nullptr || cmdSize == 0 || cmdSize > maxChunkSize || data == nullptr || dataSize == 0)
+    return false;
+  return Submit({.pinCsn = pinCsn,
+                 .priority = priority,
+                 .cmd = cmd,
+                 .cmdSize = cmdSize,
+                 .dataAddress = (uint32_t) data,
+                 .dataSize = dataSize,
+                 .nbRepeats = 0,
+                 .receiving = true,
+                 .taskToNotify = nullptr,
+                 .callback = callback,
+                 .context = context});
+}
+
+bool SpiMaster::WriteCmdAndBufferAsync(uint8_t pinCsn,
+                                       const uint8_t* cmd,
+                                       size_t cmdSize,
+                                       const uint8_t* data,
+                                       size_t dataSize,
+                                       Priority priority,
+                                       TransferDoneCallback callback,
+                                       void* context) {
+  if (cmd == nullptr || cmdSize == 0 || cmdSize > maxChunkSize || data == nullptr || dataSize == 0)
+    return false;
+  return Submit({.pinCsn = pinCsn,
+                 .priority = priority,
+                 .cmd = cmd,
+                 .cmdSize = cmdSize,
+                 .dataAddress = (uint32_t) data,
+                 .dataSize = dataSize,
+                 .nbRepeats = 0,
+                 .receiving = false,
+                 .taskToNotify = nullptr,
+                 .callback = callback,
+                 .context = context});
+}
+
+bool SpiMaster::WriteCommands(uint8_t pinCsn, uint8_t pinDataCommand, const Command* commands, size_t nbCommands) {
+  if (commands == nullptr)
+    return false;
+  // Each parameter block is sent as a single EasyDMA transfer
+  for (size_t i = 0; i < nbCommands; i++) {
+    if (commands[i].nbParameters > maxChunkSize || (commands[i].nbParameters > 0 && commands[i].parameters == nullptr))
+      return false;
+  }
+  xSemaphoreTake(mutex, portMAX_DELAY);
+
+  this->pinCsn = pinCsn;
+  DisableWorkaroundForFtpan58(spiBaseAddress, 0, 0);
+  spiBaseAddress->INTENCLR = (1 << 6);
+  spiBaseAddress->INTENCLR = (1 << 1);
+  spiBaseAddress->INTENCLR = (1 << 19);
+
+  nrf_gpio_pin_clear(this->pinCsn);
+
+  // Commands and their parameters are only a few bytes long: polling is faster than waiting for the END interrupt
+  for (size_t i = 0; i < nbCommands; i++) {
+    nrf_gpio_pin_clear(pinDataCommand);
+    PrepareTx((uint32_t) &commands[i].command, 1);
+    spiBaseAddress->TASKS_START = 1;
+    while (spiBaseAddress->EVENTS_END == 0)
+      ;
+
+    if (commands[i].nbParameters > 0) {
+      nrf_gpio_pin_set(pinDataCommand);
+      PrepareTx((uint32_t) commands[i].parameters, commands[i].nbParameters);
+      spiBaseAddress->TASKS_START = 1;
+      while (spiBaseAddress->EVENTS_END == 0)
+        ;
+    }
+  }
+  nrf_gpio_pin_set(this->pinCsn);
+
+  ReleaseBus();
 
   return true;
 }
@@ -14,6 +14,7 @@ namespace Pinetime {
       enum class BitOrder : uint8_t { Msb_Lsb, Lsb_Msb };
       enum class Modes : uint8_t { Mode0, Mode1, Mode2, Mode3 };
       enum class Frequencies : uint8_t { Freq8Mhz };
+      enum class Priority : uint8_t { Low, High };
 
       struct Parameters {
         BitOrder bitOrder;
@@ -24,6 +25,19 @@ namespace Pinetime {
         uint8_t pinMISO;
       };
 
+      // A command byte followed by its parameters, sent with the Data/Command pin low then high.
+      // The command and the parameters must be located in RAM (EasyDMA).
+      // Parameter blocks longer than maxChunkSize are rejected.
+      struct Command {
+        uint8_t command;
+        const uint8_t* parameters;
+        size_t nbParameters;
+      };
+
+      // Called from the END interrupt handler once an asynchronous transfer is complete and its CS pin is released.
+      // Sets higherPriorityTaskWoken to pdTRUE if it unblocked a task with a higher priority (see xSemaphoreGiveFromISR()).
+      using TransferDoneCallback = void (*)(void* context, BaseType_t* higherPriorityTaskWoken);
+
       SpiMaster(const SpiModule spi, const Parameters& params);
       SpiMaster(const SpiMaster&) = delete;
       SpiMaster& operator=(const SpiMaster&) = delete;
@@ -31,22 +45,101 @@ namespace Pinetime {
       SpiMaster& operator=(SpiMaster&&) = delete;
 
       bool Init();
-      bool Write(uint8_t pinCsn, const uint8_t* data, size_t size);
+      // Writes larger than a few bytes, repeated writes and asynchronous transfers are queued and driven by the END interrupt.
+      // Queued transfers of the Low priority are suspended between two chunks when a High priority one is queued,
+      // so that a flash read does not wait for the end of a whole display area.
+      bool Write(uint8_t pinCsn, const uint8_t* data, size_t size, Priority priority = Priority::Low);
+      // Sends the same buffer (up to 255 bytes) nbRepeats times in a row, in a single transaction
+      bool WriteRepeated(uint8_t pinCsn, const uint8_t* data, size_t size, size_t nbRepeats, Priority priority = Priority::Low);
       bool Read(uint8_t pinCsn, uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize);
 
       bool WriteCmdAndBuffer(uint8_t pinCsn, const uint8_t* cmd, size_t cmdSize, const uint8_t* data, size_t dataSize);
+      bool WriteCommands(uint8_t pinCsn, uint8_t pinDataCommand, const Command* commands, size_t nbCommands);
+
+      // Same as Read() and WriteCmdAndBuffer(), but they return as soon as the transfer is queued,
+      // and callback is called once the transfer is complete. cmd and data must stay valid until then.
+      bool ReadAsync(uint8_t pinCsn,
+                     const uint8_t* cmd,
+                     size_t cmdSize,
+                     uint8_t* data,
+                     size_t dataSize,
+                     Priority priority,
+                     TransferDoneCallback callback,
+                     void* context);
+      bool WriteCmdAndBufferAsync(uint8_t pinCsn,
+                                  const uint8_t* cmd,
+                                  size_t cmdSize,
+                                  const uint8_t* data,
+                                  size_t dataSize,
+                                  Priority priority,
+                                  TransferDoneCallback callback,
+                                  void* context);
 
       void OnStartedEvent();
       void OnEndEvent();
+      void OnStreamEndEvent();
 
       void Sleep();
       void Wakeup();
 
     private:
+      // A transfer driven by the END interrupt: an optional command, then dataSize bytes sent or received in chunks.
+      // When nbRepeats > 0, the dataSize bytes are sent nbRepeats times instead.
+      struct Transaction {
+        uint8_t pinCsn;
+        Priority priority;
+        const uint8_t* cmd;
+        size_t cmdSize;
+        uint32_t dataAddress;
+        size_t dataSize;
+        size_t nbRepeats;
+        bool receiving;
+        TaskHandle_t taskToNotify;
+        TransferDoneCallback callback;
+        void* context;
+      };
+
       void SetupWorkaroundForFtpan58(NRF_SPIM_Type* spim, uint32_t ppi_channel, uint32_t gpiote_channel);
       void DisableWorkaroundForFtpan58(NRF_SPIM_Type* spim, uint32_t ppi_channel, uint32_t gpiote_channel);
       void PrepareTx(const volatile uint32_t bufferAddress, const volatile size_t size);
       void PrepareRx(const volatile uint32_t bufferAddress, const volatile size_t size);
+      void SetupStream(size_t nbChunks, bool repeatChunk);
+      void DisableStream();
+
+      bool Submit(const Transaction& transaction);
+      // Starts the queued transaction with the highest priority, or resumes the suspended one.
+      // Returns false if there is none. Must be called by the owner of the bus, from a critical section or from the interrupt handler.
+      bool StartNextTransaction();
+      void ContinueTransaction();
+      bool HasQueuedTransaction(Priority priority) const;
+      void ReleaseBus();
+
+      // Writes up to this size are faster to poll than to complete from the END interrupt
+      static constexpr size_t maxPolledWriteSize = 4;
+      // EasyDMA transfers are limited to 255 bytes (MAXCNT is 8 bits wide on the nRF52832)
+      static constexpr size_t maxChunkSize = 255;
+      // Streamed chunks are counted by a 16 bits timer
+      static constexpr size_t maxStreamChunks = 0xffff;
+      // Low priority transactions are streamed by groups of this many chunks (~2ms at 8MHz),
+      // between which they can be suspended
+      static constexpr size_t maxPreemptibleStreamChunks = 8;
+      // Resources used to chain chunks in hardware (ArrayList + PPI) without waking the CPU between them.
+      // PPI channel 0 and GPIOTE channel 0 are used by the FTPAN-58 workaround,
+      // channels 4-5 and 20-31 are used by the BLE stack.
+      static constexpr uint32_t streamRestartPpiChannel = 1;
+      static constexpr uint32_t streamCountPpiChannel = 2;
+      static constexpr uint32_t streamStopPpiChannel = 3;
+      static constexpr uint32_t streamPpiGroup = 0;
+
+      // Transactions waiting for the bus. There is at most one transaction in flight per client.
+      static constexpr size_t maxQueuedTransactions = 4;
+      Transaction queue[maxQueuedTransactions];
+      size_t nbQueuedTransactions = 0;
+      Transaction currentTransaction;
+      bool transactionRunning = false;
+      // Low priority transaction suspended by a High priority one
+      Transaction suspendedTransaction;
+      bool transactionSuspended = false;
 
       NRF_SPIM_Type* spiBaseAddress;
       uint8_t pinCsn;
@@ -54,9 +147,7 @@ namespace Pinetime {
       SpiMaster::SpiModule spi;
       SpiMaster::Parameters params;
 
-      volatile uint32_t currentBufferAddr = 0;
-      volatile size_t currentBufferSize = 0;
-      volatile TaskHandle_t taskToNotify;
+      volatile bool streaming = false;
       SemaphoreHandle_t mutex = nullptr;
     };
   }
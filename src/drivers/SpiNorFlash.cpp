@@ -10,6 +10,10 @@ SpiNorFlash::SpiNorFlash(Spi& spi) : spi {spi} {
 }
 
 void SpiNorFlash::Init() {
+  if (transferDone == nullptr) {
+    transferDone = xSemaphoreCreateBinary();
+    transferMutex = xSemaphoreCreateMutex();
+  }
   device_id = ReadIdentificaion();
   NRF_LOG_INFO("[SpiNorFlash] Manufacturer : %d, Memory type : %d, memory density : %d",
                device_id.manufacturer,
@@ -76,7 +80,29 @@ void SpiNorFlash::Read(uint32_t address, uint8_t* buffer, size_t size) {
                           static_cast<uint8_t>(address >> 16U),
                           static_cast<uint8_t>(address >> 8U),
                           static_cast<uint8_t>(address)};
-  spi.Read(reinterpret_cast<uint8_t*>(&cmd), cmdSize, buffer, size);
+  if (!CanWaitForTransfer(size)) {
+    spi.Read(reinterpret_cast<uint8_t*>(&cmd), cmdSize, buffer, size);
+    return;
+  }
+
+  // Block on the semaphore instead of spinning, so that other tasks can run during the transfer
+  xSemaphoreTake(transferMutex, portMAX_DELAY);
+  if (spi.ReadAsync(cmd, cmdSize, buffer, size, OnTransferDone, this)) {
+    xSemaphoreTake(transferDone, portMAX_DELAY);
+  } else {
+    // The transfer queue is full, read synchronously
+    spi.Read(cmd, cmdSize, buffer, size);
+  }
+  xSemaphoreGive(transferMutex);
+}
+
+bool SpiNorFlash::CanWaitForTransfer(size_t size) const {
+  return size >= minAsyncTransferSize && transferDone != nullptr && xTaskGetSchedulerState() == taskSCHEDULER_RUNNING;
+}
+
+void SpiNorFlash::OnTransferDone(void* context, BaseType_t* higherPriorityTaskWoken) {
+  auto* flash = static_cast<SpiNorFlash*>(context);
+  xSemaphoreGiveFromISR(flash->transferDone, higherPriorityTaskWoken);
 }
 
 void SpiNorFlash::WriteEnable() {
@@ -135,7 +161,18 @@ void SpiNorFlash::Write(uint32_t address, const uint8_t* buffer, size_t size) {
     while (!WriteEnabled())
       vTaskDelay(1);
 
-    spi.WriteCmdAndBuffer(cmd, cmdSize, b, toWrite);
+    if (CanWaitForTransfer(toWrite)) {
+      xSemaphoreTake(transferMutex, portMAX_DELAY);
+      if (spi.WriteCmdAndBufferAsync(cmd, cmdSize, b, toWrite, OnTransferDone, this)) {
+        xSemaphoreTake(transferDone, portMAX_DELAY);
+      } else {
+        // The transfer queue is full, write synchronously
+        spi.WriteCmdAndBuffer(cmd, cmdSize, b, toWrite);
+      }
+      xSemaphoreGive(transferMutex);
+    } else {
+      spi.WriteCmdAndBuffer(cmd, cmdSize, b, toWrite);
+    }
 
     while (WriteInProgress())
       vTaskDelay(1);
@@ -1,6 +1,8 @@
 #pragma once
 #include <cstddef>
 #include <cstdint>
+#include <FreeRTOS.h>
+#include <semphr.h>
 
 namespace Pinetime {
   namespace Drivers {
@@ -53,9 +55,18 @@ namespace Pinetime {
         DeepPowerDown = 0xB9
       };
       static constexpr uint16_t pageSize = 256;
+      // Smaller transfers are faster to poll than to wait for
+      static constexpr size_t minAsyncTransferSize = 32;
+
+      bool CanWaitForTransfer(size_t size) const;
+      static void OnTransferDone(void* context, BaseType_t* higherPriorityTaskWoken);
 
       Spi& spi;
       Identification device_id;
+      // Given from the SPI interrupt when an asynchronous transfer is complete
+      SemaphoreHandle_t transferDone = nullptr;
+      // Only one task at a time can wait for transferDone
+      SemaphoreHandle_t transferMutex = nullptr;
     };
   }
 }
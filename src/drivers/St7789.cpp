@@ -30,19 +30,23 @@ void St7789::Init() {
 }
 
 void St7789::WriteCommand(uint8_t cmd) {
-  nrf_gpio_pin_clear(pinDataCommand);
-  WriteSpi(&cmd, 1);
+  WriteCommand(cmd, nullptr, 0);
 }
 
-void St7789::WriteData(uint8_t data) {
-  nrf_gpio_pin_set(pinDataCommand);
-  WriteSpi(&data, 1);
+void St7789::WriteCommand(uint8_t cmd, const uint8_t* parameters, size_t nbParameters) {
+  const SpiMaster::Command command {cmd, parameters, nbParameters};
+  auto ok = spi.WriteCommands(pinDataCommand, &command, 1);
+  ASSERT(ok);
 }
 
 void St7789::WriteSpi(const uint8_t* data, size_t size) {
   spi.Write(data, size);
 }
 
+void St7789::WriteSpiRepeated(const uint8_t* data, size_t size, size_t nbRepeats) {
+  spi.WriteRepeated(data, size, nbRepeats);
+}
+
 void St7789::SoftwareReset() {
   WriteCommand(static_cast<uint8_t>(Commands::SoftwareReset));
   nrf_delay_ms(150);
@@ -57,13 +61,12 @@ void St7789::SleepIn() {
 }
 
 void St7789::ColMod() {
-  WriteCommand(static_cast<uint8_t>(Commands::ColMod));
-  WriteData(0x55);
+  const uint8_t colMod = 0x55;
+  WriteCommand(static_cast<uint8_t>(Commands::ColMod), &colMod, 1);
   nrf_delay_ms(10);
 }
 
 void St7789::MemoryDataAccessControl() {
-  WriteCommand(static_cast<uint8_t>(Commands::MemoryDataAccessControl));
 #ifdef DRIVER_DISPLAY_MIRROR
   // [7] = MY = Page Address Order, 0 = Top to bottom, 1 = Bottom to top
   // [6] = MX = Column Address Order, 0 = Left to right, 1 = Right to left
@@ -72,26 +75,21 @@ void St7789::MemoryDataAccessControl() {
   // [3] = RGB = RGB/BGR Order, 0 = RGB, 1 = BGR
   // [2] = MH = Display Data Latch Order, 0 = LCD refresh from left to right, 1 = Right to left
   // [0 .. 1] = Unused
-  WriteData(0b01000000);
+  const uint8_t memoryDataAccessControl = 0b01000000;
 #else
-  WriteData(0x00);
+  const uint8_t memoryDataAccessControl = 0x00;
 #endif
+  WriteCommand(static_cast<uint8_t>(Commands::MemoryDataAccessControl), &memoryDataAccessControl, 1);
 }
 
 void St7789::ColumnAddressSet() {
-  WriteCommand(static_cast<uint8_t>(Commands::ColumnAddressSet));
-  WriteData(0x00);
-  WriteData(0x00);
-  WriteData(Width >> 8u);
-  WriteData(Width & 0xffu);
+  const uint8_t parameters[] = {0x00, 0x00, Width >> 8u, Width & 0xffu};
+  WriteCommand(static_cast<uint8_t>(Commands::ColumnAddressSet), parameters, sizeof(parameters));
 }
 
 void St7789::RowAddressSet() {
-  WriteCommand(static_cast<uint8_t>(Commands::RowAddressSet));
-  WriteData(0x00);
-  WriteData(0x00);
-  WriteData(320u >> 8u);
-  WriteData(320u & 0xffu);
+  const uint8_t parameters[] = {0x00, 0x00, Height >> 8u, Height & 0xffu};
+  WriteCommand(static_cast<uint8_t>(Commands::RowAddressSet), parameters, sizeof(parameters));
 }
 
 void St7789::DisplayInversionOn() {
@@ -109,30 +107,33 @@ void St7789::DisplayOn() {
 }
 
 void St7789::SetAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
-  WriteCommand(static_cast<uint8_t>(Commands::ColumnAddressSet));
-  WriteData(x0 >> 8);
-  WriteData(x0 & 0xff);
-  WriteData(x1 >> 8);
-  WriteData(x1 & 0xff);
-
-  WriteCommand(static_cast<uint8_t>(Commands::RowAddressSet));
-  WriteData(y0 >> 8);
-  WriteData(y0 & 0xff);
-  WriteData(y1 >> 8);
-  WriteData(y1 & 0xff);
-
-  WriteToRam();
-}
-
-void St7789::WriteToRam() {
-  WriteCommand(static_cast<uint8_t>(Commands::WriteToRam));
+  const uint8_t columns[] = {
+    static_cast<uint8_t>(x0 >> 8),
+    static_cast<uint8_t>(x0 & 0xff),
+    static_cast<uint8_t>(x1 >> 8),
+    static_cast<uint8_t>(x1 & 0xff),
+  };
+  const uint8_t rows[] = {
+    static_cast<uint8_t>(y0 >> 8),
+    static_cast<uint8_t>(y0 & 0xff),
+    static_cast<uint8_t>(y1 >> 8),
+    static_cast<uint8_t>(y1 & 0xff),
+  };
+  // Set the window and start writing to RAM in a single SPI transaction
+  const SpiMaster::Command commands[] = {
+    {static_cast<uint8_t>(Commands::ColumnAddressSet), columns, sizeof(columns)},
+    {static_cast<uint8_t>(Commands::RowAddressSet), rows, sizeof(rows)},
+    {static_cast<uint8_t>(Commands::WriteToRam), nullptr, 0},
+  };
+  auto ok = spi.WriteCommands(pinDataCommand, commands, sizeof(commands) / sizeof(commands[0]));
+  ASSERT(ok);
 }
 
 void St7789::SetVdv() {
   // By default there is a large step from pixel brightness zero to one.
   // After experimenting with VCOMS, VRH and VDV, this was found to produce good results.
-  WriteCommand(static_cast<uint8_t>(Commands::VdvSet));
-  WriteData(0x10);
+  const uint8_t vdv = 0x10;
+  WriteCommand(static_cast<uint8_t>(Commands::VdvSet), &vdv, 1);
 }
 
 void St7789::DisplayOff() {
@@ -142,9 +143,8 @@ void St7789::DisplayOff() {
 
 void St7789::VerticalScrollStartAddress(uint16_t line) {
   verticalScrollingStartAddress = line;
-  WriteCommand(static_cast<uint8_t>(Commands::VerticalScrollStartAddress));
-  WriteData(line >> 8u);
-  WriteData(line & 0x00ffu);
+  const uint8_t parameters[] = {static_cast<uint8_t>(line >> 8u), static_cast<uint8_t>(line & 0x00ffu)};
+  WriteCommand(static_cast<uint8_t>(Commands::VerticalScrollStartAddress), parameters, sizeof(parameters));
 }
 
 void St7789::Uninit() {
@@ -156,6 +156,24 @@ void St7789::DrawBuffer(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
   WriteSpi(data, size);
 }
 
+void St7789::ContinueDrawBuffer(const uint8_t* data, size_t size) {
+  WriteCommand(static_cast<uint8_t>(Commands::WriteToRamContinue));
+  nrf_gpio_pin_set(pinDataCommand);
+  WriteSpi(data, size);
+}
+
+void St7789::FillBuffer(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t* pattern, size_t size, size_t nbRepeats) {
+  SetAddrWindow(x, y, x + width - 1, y + height - 1);
+  nrf_gpio_pin_set(pinDataCommand);
+  WriteSpiRepeated(pattern, size, nbRepeats);
+}
+
+void St7789::ContinueFillBuffer(const uint8_t* pattern, size_t size, size_t nbRepeats) {
+  WriteCommand(static_cast<uint8_t>(Commands::WriteToRamContinue));
+  nrf_gpio_pin_set(pinDataCommand);
+  WriteSpiRepeated(pattern, size, nbRepeats);
+}
+
 void St7789::HardwareReset() {
   nrf_gpio_pin_clear(pinReset);
   nrf_delay_ms(10);
@@ -20,6 +20,13 @@ namespace Pinetime {
       void VerticalScrollStartAddress(uint16_t line);
 
       void DrawBuffer(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t* data, size_t size);
+      // Writes the data right after the pixels written by the previous call to DrawBuffer(),
+      // in the address window that was set by that call.
+      void ContinueDrawBuffer(const uint8_t* data, size_t size);
+      // Same as DrawBuffer() and ContinueDrawBuffer(), but the pattern is sent nbRepeats times in a row.
+      // Used to fill single color areas without reading every pixel from the LVGL buffer.
+      void FillBuffer(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t* pattern, size_t size, size_t nbRepeats);
+      void ContinueFillBuffer(const uint8_t* pattern, size_t size, size_t nbRepeats);
 
       void Sleep();
       void Wakeup();
@@ -38,14 +45,15 @@ namespace Pinetime {
       void MemoryDataAccessControl();
       void DisplayInversionOn();
       void NormalModeOn();
-      void WriteToRam();
       void DisplayOn();
       void DisplayOff();
 
       void SetAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
       void SetVdv();
       void WriteCommand(uint8_t cmd);
+      void WriteCommand(uint8_t cmd, const uint8_t* parameters, size_t nbParameters);
       void WriteSpi(const uint8_t* data, size_t size);
+      void WriteSpiRepeated(const uint8_t* data, size_t size, size_t nbRepeats);
 
       enum class Commands : uint8_t {
         SoftwareReset = 0x01,
@@ -58,13 +66,13 @@ namespace Pinetime {
         ColumnAddressSet = 0x2a,
         RowAddressSet = 0x2b,
         WriteToRam = 0x2c,
+        WriteToRamContinue = 0x3c,
         MemoryDataAccessControl = 0x36,
         VerticalScrollDefinition = 0x33,
         VerticalScrollStartAddress = 0x37,
         ColMod = 0x3a,
         VdvSet = 0xc4,
       };
-      void WriteData(uint8_t data);
       void ColumnAddressSet();
 
       static constexpr uint16_t Width = 240;
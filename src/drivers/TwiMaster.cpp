@@ -5,9 +5,6 @@
 
 using namespace Pinetime::Drivers;
 
-// TODO use shortcut to automatically send STOP when receive LastTX, for example
-// TODO use DMA/IRQ
-
 TwiMaster::TwiMaster(NRF_TWIM_Type* module, uint32_t frequency, uint8_t pinSda, uint8_t pinScl)
   : module {module}, frequency {frequency}, pinSda {pinSda}, pinScl {pinScl} {
 }
@@ -25,6 +22,7 @@ void TwiMaster::ConfigurePins() const {
 void TwiMaster::Init() {
   if (mutex == nullptr) {
     mutex = xSemaphoreCreateBinary();
+    transferDone = xSemaphoreCreateBinary();
   }
 
   ConfigurePins();
@@ -42,17 +40,31 @@ void TwiMaster::Init() {
   twiBaseAddress->EVENTS_RXSTARTED = 0;
   twiBaseAddress->EVENTS_SUSPENDED = 0;
   twiBaseAddress->EVENTS_TXSTARTED = 0;
+  twiBaseAddress->SHORTS = 0;
+  twiBaseAddress->INTENCLR = 0xffffffff;
 
   twiBaseAddress->ENABLE = (TWIM_ENABLE_ENABLE_Enabled << TWIM_ENABLE_ENABLE_Pos);
 
+  NRFX_IRQ_PRIORITY_SET(SPIM1_SPIS1_TWIM1_TWIS1_SPI1_TWI1_IRQn, 2);
+  NRFX_IRQ_ENABLE(SPIM1_SPIS1_TWIM1_TWIS1_SPI1_TWI1_IRQn);
+
   xSemaphoreGive(mutex);
 }
 
 TwiMaster::ErrorCodes TwiMaster::Read(uint8_t deviceAddress, uint8_t registerAddress, uint8_t* data, size_t size) {
+  const RegisterRead read {registerAddress, data, size};
+  return Read(deviceAddress, &read, 1);
+}
+
+TwiMaster::ErrorCodes TwiMaster::Read(uint8_t deviceAddress, const RegisterRead* reads, size_t nbReads) {
   xSemaphoreTake(mutex, portMAX_DELAY);
   Wakeup();
-  auto ret = Write(deviceAddress, &registerAddress, 1, false);
-  ret = Read(deviceAddress, data, size, true);
+  auto ret = ErrorCodes::NoError;
+  for (size_t i = 0; i < nbReads && ret == ErrorCodes::NoError; i++) {
+    // The register address must be in RAM (EasyDMA)
+    internalBuffer[0] = reads[i].registerAddress;
+    ret = Transfer(deviceAddress, internalBuffer, registerSize, reads[i].buffer, reads[i].size);
+  }
   Sleep();
   xSemaphoreGive(mutex);
   return ret;
@@ -64,97 +76,65 @@ TwiMaster::ErrorCodes TwiMaster::Write(uint8_t deviceAddress, uint8_t registerAd
   Wakeup();
   internalBuffer[0] = registerAddress;
   std::memcpy(internalBuffer + 1, data, size);
-  auto ret = Write(deviceAddress, internalBuffer, size + 1, true);
+  auto ret = Transfer(deviceAddress, internalBuffer, size + registerSize, nullptr, 0);
   Sleep();
   xSemaphoreGive(mutex);
   return ret;
 }
 
-TwiMaster::ErrorCodes TwiMaster::Read(uint8_t deviceAddress, uint8_t* buffer, size_t size, bool stop) {
+TwiMaster::ErrorCodes TwiMaster::Transfer(uint8_t deviceAddress, const uint8_t* txData, size_t txSize, uint8_t* rxData, size_t rxSize) {
   twiBaseAddress->ADDRESS = deviceAddress;
-  twiBaseAddress->TASKS_RESUME = 0x1UL;
-  twiBaseAddress->RXD.PTR = (uint32_t) buffer;
-  twiBaseAddress->RXD.MAXCNT = size;
-
-  twiBaseAddress->TASKS_STARTRX = 1;
-
-  while (!twiBaseAddress->EVENTS_RXSTARTED && !twiBaseAddress->EVENTS_ERROR)
-    ;
-  twiBaseAddress->EVENTS_RXSTARTED = 0x0UL;
-
-  txStartedCycleCount = DWT->CYCCNT;
-  uint32_t currentCycleCount;
-  while (!twiBaseAddress->EVENTS_LASTRX && !twiBaseAddress->EVENTS_ERROR) {
-    currentCycleCount = DWT->CYCCNT;
-    if ((currentCycleCount - txStartedCycleCount) > HwFreezedDelay) {
-      FixHwFreezed();
-      return ErrorCodes::TransactionFailed;
-    }
-  }
-  twiBaseAddress->EVENTS_LASTRX = 0x0UL;
-
-  if (stop || twiBaseAddress->EVENTS_ERROR) {
-    twiBaseAddress->TASKS_STOP = 0x1UL;
-    while (!twiBaseAddress->EVENTS_STOPPED)
-      ;
-    twiBaseAddress->EVENTS_STOPPED = 0x0UL;
+  twiBaseAddress->TXD.PTR = (uint32_t) txData;
+  twiBaseAddress->TXD.MAXCNT = txSize;
+  twiBaseAddress->RXD.PTR = (uint32_t) rxData;
+  twiBaseAddress->RXD.MAXCNT = rxSize;
+
+  // The repeated start and the stop are triggered by the shortcuts: the CPU is only woken up once the bus is stopped
+  if (rxSize > 0) {
+    twiBaseAddress->SHORTS = TWIM_SHORTS_LASTTX_STARTRX_Msk | TWIM_SHORTS_LASTRX_STOP_Msk;
   } else {
-    twiBaseAddress->TASKS_SUSPEND = 0x1UL;
-    while (!twiBaseAddress->EVENTS_SUSPENDED)
-      ;
-    twiBaseAddress->EVENTS_SUSPENDED = 0x0UL;
+    twiBaseAddress->SHORTS = TWIM_SHORTS_LASTTX_STOP_Msk;
   }
 
-  if (twiBaseAddress->EVENTS_ERROR) {
-    twiBaseAddress->EVENTS_ERROR = 0x0UL;
-  }
-  return ErrorCodes::NoError;
-}
-
-TwiMaster::ErrorCodes TwiMaster::Write(uint8_t deviceAddress, const uint8_t* data, size_t size, bool stop) {
-  twiBaseAddress->ADDRESS = deviceAddress;
-  twiBaseAddress->TASKS_RESUME = 0x1UL;
-  twiBaseAddress->TXD.PTR = (uint32_t) data;
-  twiBaseAddress->TXD.MAXCNT = size;
-
+  errorSource = 0;
+  twiBaseAddress->EVENTS_ERROR = 0;
+  twiBaseAddress->EVENTS_STOPPED = 0;
+  twiBaseAddress->INTENSET = TWIM_INTENSET_STOPPED_Msk | TWIM_INTENSET_ERROR_Msk;
   twiBaseAddress->TASKS_STARTTX = 1;
 
-  while (!twiBaseAddress->EVENTS_TXSTARTED && !twiBaseAddress->EVENTS_ERROR)
-    ;
-  twiBaseAddress->EVENTS_TXSTARTED = 0x0UL;
-
-  txStartedCycleCount = DWT->CYCCNT;
-  uint32_t currentCycleCount;
-  while (!twiBaseAddress->EVENTS_LASTTX && !twiBaseAddress->EVENTS_ERROR) {
-    currentCycleCount = DWT->CYCCNT;
-    if ((currentCycleCount - txStartedCycleCount) > HwFreezedDelay) {
-      FixHwFreezed();
-      return ErrorCodes::TransactionFailed;
-    }
+  if (xSemaphoreTake(transferDone, transferTimeout) != pdTRUE) {
+    twiBaseAddress->INTENCLR = TWIM_INTENCLR_STOPPED_Msk | TWIM_INTENCLR_ERROR_Msk;
+    FixHwFreezed();
+    // The bus may have been stopped in the meantime
+    xSemaphoreTake(transferDone, 0);
+    twiBaseAddress->SHORTS = 0;
+    return ErrorCodes::TransactionFailed;
   }
-  twiBaseAddress->EVENTS_LASTTX = 0x0UL;
 
-  if (stop || twiBaseAddress->EVENTS_ERROR) {
-    twiBaseAddress->TASKS_STOP = 0x1UL;
-    while (!twiBaseAddress->EVENTS_STOPPED)
-      ;
-    twiBaseAddress->EVENTS_STOPPED = 0x0UL;
-  } else {
-    twiBaseAddress->TASKS_SUSPEND = 0x1UL;
-    while (!twiBaseAddress->EVENTS_SUSPENDED)
-      ;
-    twiBaseAddress->EVENTS_SUSPENDED = 0x0UL;
-  }
+  twiBaseAddress->SHORTS = 0;
+  return (errorSource == 0) ? ErrorCodes::NoError : ErrorCodes::TransactionFailed;
+}
 
+void TwiMaster::OnInterrupt() {
   if (twiBaseAddress->EVENTS_ERROR) {
-    twiBaseAddress->EVENTS_ERROR = 0x0UL;
-    uint32_t error = twiBaseAddress->ERRORSRC;
-    twiBaseAddress->ERRORSRC = error;
+    twiBaseAddress->EVENTS_ERROR = 0;
+    errorSource = twiBaseAddress->ERRORSRC;
+    twiBaseAddress->ERRORSRC = errorSource;
+    // The shortcuts are not triggered after a NACK: stop the bus
+    twiBaseAddress->TASKS_RESUME = 1;
+    twiBaseAddress->TASKS_STOP = 1;
   }
 
-  return ErrorCodes::NoError;
+  if (twiBaseAddress->EVENTS_STOPPED) {
+    twiBaseAddress->EVENTS_STOPPED = 0;
+    twiBaseAddress->INTENCLR = TWIM_INTENCLR_STOPPED_Msk | TWIM_INTENCLR_ERROR_Msk;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    xSemaphoreGiveFromISR(transferDone, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+  }
 }
 
+// The peripheral is disabled between transfers: enabled TWIM and GPIOTE draw a static current (nRF52832 errata 89)
 void TwiMaster::Sleep() {
   twiBaseAddress->ENABLE = (TWIM_ENABLE_ENABLE_Disabled << TWIM_ENABLE_ENABLE_Pos);
 }
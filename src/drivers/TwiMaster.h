@@ -10,23 +10,36 @@ namespace Pinetime {
     public:
       enum class ErrorCodes { NoError, TransactionFailed };
 
+      // A block of consecutive registers to read
+      struct RegisterRead {
+        uint8_t registerAddress;
+        uint8_t* buffer;
+        size_t size;
+      };
+
       TwiMaster(NRF_TWIM_Type* module, uint32_t frequency, uint8_t pinSda, uint8_t pinScl);
 
       void Init();
       ErrorCodes Read(uint8_t deviceAddress, uint8_t registerAddress, uint8_t* buffer, size_t size);
+      // Reads several blocks of registers of the same device in a row, without releasing the bus between them
+      ErrorCodes Read(uint8_t deviceAddress, const RegisterRead* reads, size_t nbReads);
       ErrorCodes Write(uint8_t deviceAddress, uint8_t registerAddress, const uint8_t* data, size_t size);
 
       void Sleep();
       void Wakeup();
 
+      void OnInterrupt();
+
     private:
-      ErrorCodes Read(uint8_t deviceAddress, uint8_t* buffer, size_t size, bool stop);
-      ErrorCodes Write(uint8_t deviceAddress, const uint8_t* data, size_t size, bool stop);
+      ErrorCodes Transfer(uint8_t deviceAddress, const uint8_t* txData, size_t txSize, uint8_t* rxData, size_t rxSize);
       void FixHwFreezed();
       void ConfigurePins() const;
 
       NRF_TWIM_Type* twiBaseAddress;
       SemaphoreHandle_t mutex = nullptr;
+      // Given from the interrupt handler once the bus is stopped
+      SemaphoreHandle_t transferDone = nullptr;
+      volatile uint32_t errorSource = 0;
       NRF_TWIM_Type* module;
       uint32_t frequency;
       uint8_t pinSda;
@@ -34,8 +47,8 @@ namespace Pinetime {
       static constexpr uint8_t maxDataSize {16};
       static constexpr uint8_t registerSize {1};
       uint8_t internalBuffer[maxDataSize + registerSize];
-      uint32_t txStartedCycleCount = 0;
-      static constexpr uint32_t HwFreezedDelay {161000};
+      // Transfers take less than 1ms: the peripheral is frozen if they are not done after this delay
+      static constexpr TickType_t transferTimeout {pdMS_TO_TICKS(10)};
     };
   }
 }
@@ -1,14 +1,49 @@
 #include "heartratetask/HeartRateTask.h"
 #include <drivers/Hrs3300.h>
 #include <components/heartrate/HeartRateController.h>
+#include <components/motion/MotionController.h>
+#include <components/history/HistoryController.h>
 #include <nrf_log.h>
+#include <array>
 
 using namespace Pinetime::Applications;
 
+namespace {
+  struct SensorLevel {
+    Pinetime::Drivers::Hrs3300::Resolution resolution;
+    Pinetime::Drivers::Hrs3300::WaitTime waitTime;
+    uint8_t drive;
+  };
+
+  // All levels sample every ~100ms (conversion + wait time), as expected by Ppg
+  constexpr std::array<SensorLevel, 4> sensorLevels {{
+    // 25ms LED pulses at 12.5mA
+    {Pinetime::Drivers::Hrs3300::Resolution::Bits14, Pinetime::Drivers::Hrs3300::WaitTime::Ms75, 0},
+    // 50ms LED pulses at 12.5mA, as configured by Hrs3300::Init()
+    {Pinetime::Drivers::Hrs3300::Resolution::Bits15, Pinetime::Drivers::Hrs3300::WaitTime::Ms50, 0},
+    // 50ms LED pulses at 20mA
+    {Pinetime::Drivers::Hrs3300::Resolution::Bits15, Pinetime::Drivers::Hrs3300::WaitTime::Ms50, 1},
+    // 50ms LED pulses at 30mA
+    {Pinetime::Drivers::Hrs3300::Resolution::Bits15, Pinetime::Drivers::Hrs3300::WaitTime::Ms50, 2},
+  }};
+
+  // Number of consecutive analyses (one every 0.5s) needed to change the sensor level. The level is raised quickly
+  // when the signal is lost in the noise, and lowered slowly when it is comfortably above it.
+  constexpr uint8_t analysesBeforeRaising = 4;
+  constexpr uint8_t analysesBeforeLowering = 20;
+  constexpr float comfortableSignalToNoise = 2.0f * Pinetime::Controllers::Ppg::signalToNoiseThreshold;
+}
+
 HeartRateTask::HeartRateTask(Drivers::Hrs3300& heartRateSensor,
                              Controllers::HeartRateController& controller,
+                             Controllers::MotionController& motionController,
+                             Controllers::HistoryController& historyController,
                              Controllers::Settings& settings)
-  : heartRateSensor {heartRateSensor}, controller {controller}, settings {settings} {
+  : heartRateSensor {heartRateSensor},
+    controller {controller},
+    motionController {motionController},
+    historyController {historyController},
+    settings {settings} {
 }
 
 void HeartRateTask::Start() {
@@ -93,6 +128,10 @@ void HeartRateTask::PushMessage(HeartRateTask::Messages msg) {
 
 void HeartRateTask::StartMeasurement() {
   heartRateSensor.Enable();
+  isSensorLevelRaised = false;
+  SetSensorLevel(sensorLevel);
+  // Continuous measurements run indefinitely, update the spectrum on each sample instead of once per analysis
+  ppg.SetIncremental(IsContinuosModeActivated());
   ppg.Reset(true);
   vTaskDelay(100);
   measurementStart = xTaskGetTickCount();
@@ -122,8 +161,15 @@ void HeartRateTask::HandleBackgroundWaiting() {
 }
 
 void HeartRateTask::HandleSensorData(int* lastBpm) {
-  int8_t ambient = ppg.Preprocess(heartRateSensor.ReadHrs(), heartRateSensor.ReadAls());
+  auto samples = heartRateSensor.ReadSamples();
+  // The motion samples reach the controller in FIFO batches, they are resampled with a constant delay so that a sample
+  // is always available. The delay only shifts the phase of the motion series, not its spectrum.
+  int32_t motion = motionController.MagnitudeAt(xTaskGetTickCount() - Controllers::MotionController::sampleLatency);
+  int8_t ambient = ppg.Preprocess(samples.hrs, samples.als, motion);
   int bpm = ppg.HeartRate();
+  if (ppg.IsNewAnalysis() && ambient == 0) {
+    AdaptSensorLevel();
+  }
 
   // If ambient light detected or a reset requested (bpm < 0)
   if (ambient > 0) {
@@ -143,6 +189,7 @@ void HeartRateTask::HandleSensorData(int* lastBpm) {
   if (bpm != 0) {
     *lastBpm = bpm;
     controller.Update(Controllers::HeartRateController::States::Running, bpm);
+    historyController.AddHeartRate(bpm);
     if (state == States::Measuring || IsContinuosModeActivated()) {
       return;
     }
@@ -164,6 +211,38 @@ void HeartRateTask::HandleSensorData(int* lastBpm) {
   }
 }
 
+void HeartRateTask::AdaptSensorLevel() {
+  float signalToNoise = ppg.SignalToNoiseRatio();
+  if (signalToNoise <= Controllers::Ppg::signalToNoiseThreshold) {
+    goodAnalyses = 0;
+    if (sensorLevel < sensorLevels.size() - 1 && ++failedAnalyses >= analysesBeforeRaising) {
+      // Don't lower the level again during this measurement, so that it doesn't oscillate
+      isSensorLevelRaised = true;
+      SetSensorLevel(sensorLevel + 1);
+      ppg.Reset(true);
+    }
+  } else if (signalToNoise >= comfortableSignalToNoise) {
+    failedAnalyses = 0;
+    if (sensorLevel > 0 && !isSensorLevelRaised && ++goodAnalyses >= analysesBeforeLowering) {
+      SetSensorLevel(sensorLevel - 1);
+      ppg.Reset(true);
+    }
+  } else {
+    goodAnalyses = 0;
+    failedAnalyses = 0;
+  }
+}
+
+// The signal level changes with the configuration, the caller must reset the acquisition buffers
+void HeartRateTask::SetSensorLevel(uint8_t level) {
+  sensorLevel = level;
+  goodAnalyses = 0;
+  failedAnalyses = 0;
+  heartRateSensor.SetResolution(sensorLevels[level].resolution);
+  heartRateSensor.SetWaitTime(sensorLevels[level].waitTime);
+  heartRateSensor.SetDrive(sensorLevels[level].drive);
+}
+
 TickType_t HeartRateTask::CurrentTaskDelay() {
   switch (state) {
     case States::Measuring:
@@ -1,4 +1,5 @@
 #pragma once
+#include <atomic>
 #include <FreeRTOS.h>
 #include <task.h>
 #include <queue.h>
@@ -14,6 +15,8 @@ namespace Pinetime {
 
   namespace Controllers {
     class HeartRateController;
+    class MotionController;
+    class HistoryController;
   }
 
   namespace Applications {
@@ -24,11 +27,18 @@ namespace Pinetime {
 
       explicit HeartRateTask(Drivers::Hrs3300& heartRateSensor,
                              Controllers::HeartRateController& controller,
+                             Controllers::MotionController& motionController,
+                             Controllers::HistoryController& historyController,
                              Controllers::Settings& settings);
       void Start();
       void Work();
       void PushMessage(Messages msg);
 
+      // Can be called from any task
+      bool IsMeasuring() const {
+        return state == States::Measuring || state == States::BackgroundMeasuring;
+      }
+
     private:
       static void Process(void* instance);
       void StartMeasurement();
@@ -37,6 +47,8 @@ namespace Pinetime {
 
       void HandleBackgroundWaiting();
       void HandleSensorData(int* lastBpm);
+      void AdaptSensorLevel();
+      void SetSensorLevel(uint8_t level);
       TickType_t CurrentTaskDelay();
 
       TickType_t GetHeartRateBackgroundMeasurementIntervalInTicks();
@@ -45,13 +57,22 @@ namespace Pinetime {
 
       TaskHandle_t taskHandle;
       QueueHandle_t messageQueue;
-      States state = States::Running;
+      std::atomic<States> state = States::Running;
       Drivers::Hrs3300& heartRateSensor;
       Controllers::HeartRateController& controller;
+      Controllers::MotionController& motionController;
+      Controllers::HistoryController& historyController;
       Controllers::Settings& settings;
       Controllers::Ppg ppg;
       TickType_t backgroundWaitingStart = 0;
       TickType_t measurementStart = 0;
+
+      // Index in the sensor configurations, from the lowest LED on time to the strongest signal
+      static constexpr uint8_t defaultSensorLevel = 1;
+      uint8_t sensorLevel = defaultSensorLevel;
+      uint8_t goodAnalyses = 0;
+      uint8_t failedAnalyses = 0;
+      bool isSensorLevelRaised = false;
     };
 
   }
@@ -41,7 +41,7 @@ Pinetime::Drivers::SpiMaster spi {Pinetime::Drivers::SpiMaster::SpiModule::SPI0,
                                    Pinetime::PinMap::SpiSck,
                                    Pinetime::PinMap::SpiMosi,
                                    Pinetime::PinMap::SpiMiso}};
-Pinetime::Drivers::Spi flashSpi {spi, Pinetime::PinMap::SpiFlashCsn};
+Pinetime::Drivers::Spi flashSpi {spi, Pinetime::PinMap::SpiFlashCsn, Pinetime::Drivers::SpiMaster::Priority::High};
 Pinetime::Drivers::SpiNorFlash spiNorFlash {flashSpi};
 
 Pinetime::Drivers::Spi lcdSpi {spi, Pinetime::PinMap::SpiLcdCsn};
@@ -72,6 +72,13 @@ void SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQHandler(void) {
     NRF_SPIM0->EVENTS_STOPPED = 0;
   }
 }
+
+void TIMER2_IRQHandler(void) {
+  if (((NRF_TIMER2->INTENSET & TIMER_INTENSET_COMPARE1_Msk) != 0) && NRF_TIMER2->EVENTS_COMPARE[1] == 1) {
+    NRF_TIMER2->EVENTS_COMPARE[1] = 0;
+    spi.OnStreamEndEvent();
+  }
+}
 }
 
 void RefreshWatchdog() {
@@ -14,6 +14,7 @@ namespace Pinetime {
       BleFirmwareUpdateStarted,
       BleFirmwareUpdateFinished,
       OnTouchEvent,
+      OnMotionEvent,
       HandleButtonEvent,
       HandleButtonTimerEvent,
       OnDisplayTaskSleeping,
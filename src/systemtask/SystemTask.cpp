@@ -50,6 +50,7 @@ SystemTask::SystemTask(Drivers::SpiMaster& spi,
                        Pinetime::Applications::DisplayApp& displayApp,
                        Pinetime::Applications::HeartRateTask& heartRateApp,
                        Pinetime::Controllers::FS& fs,
+                       Pinetime::Controllers::HistoryController& historyController,
                        Pinetime::Controllers::TouchHandler& touchHandler,
                        Pinetime::Controllers::ButtonHandler& buttonHandler)
   : spi {spi},
@@ -70,6 +71,7 @@ SystemTask::SystemTask(Drivers::SpiMaster& spi,
     displayApp {displayApp},
     heartRateApp(heartRateApp),
     fs {fs},
+    historyController {historyController},
     touchHandler {touchHandler},
     buttonHandler {buttonHandler},
     nimbleController(*this,
@@ -80,7 +82,8 @@ SystemTask::SystemTask(Drivers::SpiMaster& spi,
                      spiNorFlash,
                      heartRateController,
                      motionController,
-                     fs) {
+                     fs,
+                     historyController) {
 }
 
 void SystemTask::Start() {
@@ -134,11 +137,20 @@ void SystemTask::Work() {
   motionSensor.Init();
   motionController.Init(motionSensor.DeviceType());
   settingsController.Init();
+  historyController.Init();
 
   displayApp.Register(this);
   displayApp.Register(&nimbleController.weather());
   displayApp.Register(&nimbleController.music());
   displayApp.Register(&nimbleController.navigation());
+  displayApp.Register(&nimbleController.frameProfiler());
+  dateTimeController.SetChangeListener(&displayApp);
+  batteryController.SetChangeListener(&displayApp);
+  bleController.SetChangeListener(&displayApp);
+  notificationManager.SetChangeListener(&displayApp);
+  heartRateController.SetChangeListener(&displayApp);
+  motionController.SetChangeListener(&displayApp);
+  nimbleController.weather().SetChangeListener(&displayApp);
   displayApp.Start(bootError);
 
   heartRateSensor.Init();
@@ -173,6 +185,12 @@ void SystemTask::Work() {
   nrfx_gpiote_in_init(PinMap::PowerPresent, &pinConfig, nrfx_gpiote_evt_handler);
   nrfx_gpiote_in_event_enable(PinMap::PowerPresent, true);
 
+  // Motion sensor FIFO watermark
+  pinConfig.sense = NRF_GPIOTE_POLARITY_LOTOHI;
+  pinConfig.pull = NRF_GPIO_PIN_NOPULL;
+  nrfx_gpiote_in_init(PinMap::Bma421Irq, &pinConfig, nrfx_gpiote_evt_handler);
+  nrfx_gpiote_in_event_enable(PinMap::Bma421Irq, true);
+
   batteryController.MeasureVoltage();
 
   measureBatteryTimer = xTimerCreate("measureBattery", batteryMeasurementPeriod, pdTRUE, this, MeasureBatteryTimerCallback);
@@ -181,10 +199,20 @@ void SystemTask::Work() {
 #pragma clang diagnostic push
 #pragma ide diagnostic ignored "EndlessLoop"
   while (true) {
-    UpdateMotion();
+    if (motionSensor.IsOk()) {
+      UpdateMotionInterrupts();
+
+      // The interrupt line stays high until the FIFO is drained and the gestures are read, which also catches up on
+      // events that could not be processed when the interrupt fired (while going to sleep or waking up, for example).
+      if (nrf_gpio_pin_read(PinMap::Bma421Irq) != 0) {
+        UpdateMotion();
+      }
+    }
 
+    // Motion samples wake this task up on their own, so there is no need to spin as fast while sleeping
+    TickType_t loopPeriod = (state == SystemTaskState::Sleeping && !isBleDiscoveryTimerRunning) ? sleepingLoopPeriod : runningLoopPeriod;
     Messages msg;
-    if (xQueueReceive(systemTasksMsgQueue, &msg, 100) == pdTRUE) {
+    if (xQueueReceive(systemTasksMsgQueue, &msg, loopPeriod) == pdTRUE) {
       switch (msg) {
         case Messages::EnableSleeping:
           // Make sure that exiting an app doesn't enable sleeping,
@@ -276,6 +304,7 @@ void SystemTask::Work() {
           break;
         case Messages::BleFirmwareUpdateFinished:
           if (bleController.State() == Pinetime::Controllers::Ble::FirmwareUpdateStates::Validated) {
+            historyController.Flush();
             NVIC_SystemReset();
           }
           doNotGoToSleep = false;
@@ -293,6 +322,9 @@ void SystemTask::Work() {
           doNotGoToSleep = false;
           // TODO add intent of fs access icon or something
           break;
+        case Messages::OnMotionEvent:
+          // Motion events are processed at the beginning of the next iteration
+          break;
         case Messages::OnTouchEvent:
           if (touchHandler.ProcessTouchInfo(touchPanel.GetTouchInfo())) {
             displayApp.PushMessage(Pinetime::Applications::Display::Messages::TouchEvent);
@@ -333,11 +365,19 @@ void SystemTask::Work() {
           state = SystemTaskState::Sleeping;
           break;
         case Messages::OnNewDay:
-          // We might be sleeping (with TWI device disabled.
-          // Remember we'll have to reset the counter next time we're awake
+          // The counter is reset by the next motion update, which is not triggered by the sensor while the watch
+          // sleeps without anything requesting samples
           stepCounterMustBeReset = true;
+          if (motionSensor.IsOk()) {
+            UpdateMotion();
+          }
           break;
         case Messages::OnNewHour:
+          // Read the step counter of the sensor, the step count is only updated by the motion interrupts otherwise
+          if (motionSensor.IsOk()) {
+            UpdateMotion();
+          }
+          historyController.AddHourlySteps(motionController.NbSteps());
           using Pinetime::Controllers::AlarmController;
           if (settingsController.GetNotificationStatus() != Controllers::Settings::Notification::Sleep &&
               settingsController.GetChimeOption() == Controllers::Settings::ChimesOption::Hours &&
@@ -401,6 +441,10 @@ void SystemTask::Work() {
       }
     }
 
+    if (historyController.IsFlushNeeded()) {
+      FlushHistory();
+    }
+
     monitor.Process();
     uint32_t systick_counter = nrf_rtc_counter_get(portNRF_RTC_REG);
     dateTimeController.UpdateTime(systick_counter);
@@ -412,25 +456,61 @@ void SystemTask::Work() {
 #pragma clang diagnostic pop
 }
 
-void SystemTask::UpdateMotion() {
+void SystemTask::FlushHistory() {
   if (state == SystemTaskState::GoingToSleep || state == SystemTaskState::WakingUp) {
     return;
   }
 
-  if (state == SystemTaskState::Sleeping && !(settingsController.isWakeUpModeOn(Pinetime::Controllers::Settings::WakeUpMode::RaiseWrist) ||
-                                              settingsController.isWakeUpModeOn(Pinetime::Controllers::Settings::WakeUpMode::Shake) ||
-                                              motionController.GetService()->IsMotionNotificationSubscribed())) {
+  // The external flash is asleep while the watch is sleeping, wake it up for the duration of the write
+  bool isSleeping = state == SystemTaskState::Sleeping;
+  if (isSleeping) {
+    spi.Wakeup();
+    spiNorFlash.Wakeup();
+  }
+  historyController.Flush();
+  if (isSleeping) {
+    if (BootloaderVersion::IsValid()) {
+      spiNorFlash.Sleep();
+    }
+    spi.Sleep();
+  }
+}
+
+void SystemTask::UpdateMotion() {
+  if (state == SystemTaskState::GoingToSleep || state == SystemTaskState::WakingUp) {
     return;
   }
 
   if (stepCounterMustBeReset) {
     motionSensor.ResetStepCounter();
+    motionController.ResetStepCount();
     stepCounterMustBeReset = false;
   }
 
-  auto motionValues = motionSensor.Process();
+  auto nbValues = motionSensor.Process(motionValues, Drivers::Bma421::maxFifoSamples);
+
+  auto gestures = motionSensor.GetGestures();
+  if (gestures.anyMotion) {
+    isMoving = true;
+  }
+  if (gestures.noMotion) {
+    isMoving = false;
+  }
+  // The sensor always runs its wrist tilt detector, it only wakes the watch when it is selected in the settings
+  if (gestures.wristTilt && state == SystemTaskState::Sleeping &&
+      settingsController.GetWakeUpDetection() == Controllers::Settings::WakeUpDetection::Sensor &&
+      settingsController.GetNotificationStatus() != Controllers::Settings::Notification::Sleep &&
+      settingsController.isWakeUpModeOn(Pinetime::Controllers::Settings::WakeUpMode::RaiseWrist)) {
+    GoToRunning();
+  }
 
-  motionController.Update(motionValues.x, motionValues.y, motionValues.z, motionValues.steps);
+  if (nbValues == 0) {
+    return;
+  }
+
+  // The last sample of the FIFO is the most recent one
+  constexpr TickType_t samplePeriod = pdMS_TO_TICKS(Drivers::Bma421::fifoSamplePeriodMs);
+  motionController.Update({motionValues, nbValues}, xTaskGetTickCount(), samplePeriod);
 
   if (settingsController.GetNotificationStatus() != Controllers::Settings::Notification::Sleep) {
     if ((settingsController.isWakeUpModeOn(Pinetime::Controllers::Settings::WakeUpMode::RaiseWrist) &&
@@ -446,6 +526,31 @@ void SystemTask::UpdateMotion() {
   }
 }
 
+void SystemTask::UpdateMotionInterrupts() {
+  using WakeUpMode = Pinetime::Controllers::Settings::WakeUpMode;
+  bool raiseWrist = settingsController.isWakeUpModeOn(WakeUpMode::RaiseWrist);
+  bool shake = settingsController.isWakeUpModeOn(WakeUpMode::Shake);
+  bool notificationsSubscribed = motionController.GetService()->IsMotionNotificationSubscribed();
+  bool countSteps = motionController.IsStepCountingInSoftware();
+  // The heart rate measurement rejects motion artifacts from the acceleration samples
+  bool measuringHeartRate = heartRateApp.IsMeasuring();
+
+  if (state != SystemTaskState::Sleeping) {
+    motionSensor.SetInterrupts(true, false, false);
+  } else if (settingsController.GetWakeUpDetection() == Controllers::Settings::WakeUpDetection::Sensor &&
+             motionSensor.AreGesturesAvailable()) {
+    // The sensor detects wrist tilts on its own. Samples are only needed to detect a shake once the sensor
+    // reports that the watch is moving.
+    motionSensor.SetInterrupts(countSteps || notificationsSubscribed || measuringHeartRate || (shake && isMoving), raiseWrist, shake);
+  } else {
+    motionSensor.SetInterrupts(countSteps || raiseWrist || shake || notificationsSubscribed || measuringHeartRate, false, false);
+  }
+}
+
+void SystemTask::OnMotionEvent() {
+  PushMessage(Messages::OnMotionEvent);
+}
+
 void SystemTask::HandleButtonAction(Controllers::ButtonActions action) {
   if (IsSleeping()) {
     return;
@@ -17,6 +17,7 @@
 #include "components/ble/NotificationManager.h"
 #include "components/alarm/AlarmController.h"
 #include "components/fs/FS.h"
+#include "components/history/HistoryController.h"
 #include "touchhandler/TouchHandler.h"
 #include "buttonhandler/ButtonHandler.h"
 #include "buttonhandler/ButtonActions.h"
@@ -71,6 +72,7 @@ namespace Pinetime {
                  Pinetime::Applications::DisplayApp& displayApp,
                  Pinetime::Applications::HeartRateTask& heartRateApp,
                  Pinetime::Controllers::FS& fs,
+                 Pinetime::Controllers::HistoryController& historyController,
                  Pinetime::Controllers::TouchHandler& touchHandler,
                  Pinetime::Controllers::ButtonHandler& buttonHandler);
 
@@ -78,6 +80,7 @@ namespace Pinetime {
       void PushMessage(Messages msg);
 
       void OnTouchEvent();
+      void OnMotionEvent();
 
       void OnIdle();
       void OnDim();
@@ -118,6 +121,7 @@ namespace Pinetime {
       Pinetime::Applications::DisplayApp& displayApp;
       Pinetime::Applications::HeartRateTask& heartRateApp;
       Pinetime::Controllers::FS& fs;
+      Pinetime::Controllers::HistoryController& historyController;
       Pinetime::Controllers::TouchHandler& touchHandler;
       Pinetime::Controllers::ButtonHandler& buttonHandler;
       Pinetime::Controllers::NimbleController nimbleController;
@@ -131,11 +135,19 @@ namespace Pinetime {
       SystemTaskState state = SystemTaskState::Running;
 
       void HandleButtonAction(Controllers::ButtonActions action);
+      void FlushHistory();
       bool fastWakeUpDone = false;
 
       void GoToRunning();
       void UpdateMotion();
+      void UpdateMotionInterrupts();
+      // Set by the any-motion and no-motion gestures of the motion sensor
+      bool isMoving = false;
+      // Kept out of the stack of the task, which is small
+      Drivers::Bma421::Values motionValues[Drivers::Bma421::maxFifoSamples];
       bool stepCounterMustBeReset = false;
+      static constexpr TickType_t runningLoopPeriod = pdMS_TO_TICKS(100);
+      static constexpr TickType_t sleepingLoopPeriod = pdMS_TO_TICKS(1000);
       static constexpr TickType_t batteryMeasurementPeriod = pdMS_TO_TICKS(10 * 60 * 1000);
 
       SystemMonitor monitor;